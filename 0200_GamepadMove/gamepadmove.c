@@ -1,38 +1,88 @@
-// 0200_GamepadMove — Move a box around with the gamepad
+// 0200_GamepadMove — Move a sprite around with the gamepad
 //
 // GameTank port of OscarTutorials/0200_CursorMove.
 // The original uses keyboard input to move a cursor on a text screen.
-// Here we use gamepad d-pad to move a small box on the framebuffer.
+// Here we use gamepad d-pad to move a small arrow sprite on the
+// framebuffer.
+//
+// Key concept: sprites. The arrow's pixels are uploaded into sprite RAM
+// once at startup; after that each frame draws it with a single blit.
+// The blitter's flip bits point the arrow along the last direction moved
+// without storing mirrored copies.
 
 #include "gt.h"
+#include "gt_dirty.h"
 
 #define BOX_SIZE 8
 
+// Sprite pixels are raw VRAM values: palette indices, not the inverted
+// GT_* register values, with 0 meaning transparent
+#define _  0
+#define W  ((byte)~GT_WHITE)
+#define Y  ((byte)~GT_YELLOW)
+
+// An arrow pointing up and to the right
+static const byte arrow[BOX_SIZE * BOX_SIZE] = {
+	_, _, _, _, Y, Y, Y, Y,
+	_, _, _, _, _, _, Y, Y,
+	_, _, _, _, _, W, _, Y,
+	_, _, _, _, W, _, _, Y,
+	_, _, _, W, _, _, _, _,
+	_, _, W, _, _, _, _, _,
+	_, W, _, _, _, _, _, _,
+	W, _, _, _, _, _, _, _
+};
+
+#undef _
+#undef W
+#undef Y
+
+// Where the arrow lives in sprite RAM
+#define ARROW_GX  0
+#define ARROW_GY  0
+
 int main(void)
 {
 	gt_init();
 
+	gt_sprite_upload(ARROW_GX, ARROW_GY, BOX_SIZE, BOX_SIZE, arrow);
+
 	byte x = (GT_SCREEN_W - BOX_SIZE) / 2;
 	byte y = (GT_SCREEN_H - BOX_SIZE) / 2;
+	byte flip = 0;
 
 	for (;;)
 	{
 		// Read gamepad
 		unsigned pad = gt_read_gamepad();
 
-		// Move box according to d-pad (with boundary checks)
+		// Move arrow according to d-pad (with boundary checks), and
+		// mirror it to face the direction of travel
 		if ((pad & INPUT_UP) && y > 0)
+		{
 			y--;
+			flip &= ~GT_SPRITE_FLIP_V;
+		}
 		if ((pad & INPUT_DOWN) && y < GT_SCREEN_H - BOX_SIZE - 1)
+		{
 			y++;
+			flip |= GT_SPRITE_FLIP_V;
+		}
 		if ((pad & INPUT_LEFT) && x > 0)
+		{
 			x--;
+			flip |= GT_SPRITE_FLIP_H;
+		}
 		if ((pad & INPUT_RIGHT) && x < GT_SCREEN_W - BOX_SIZE - 1)
+		{
 			x++;
+			flip &= ~GT_SPRITE_FLIP_H;
+		}
 
-		// Clear screen and redraw box
-		gt_clear(GT_BLACK);
-		gt_draw_box(x, y, BOX_SIZE, BOX_SIZE, GT_WHITE);
+		// Erase the arrow drawn on this page two frames ago and redraw it
+		gt_dirty_clear(GT_BLACK);
+		gt_dirty_mark(x, y, BOX_SIZE, BOX_SIZE);
+		gt_blit_sprite(x, y, ARROW_GX, ARROW_GY, BOX_SIZE, BOX_SIZE, flip);
 
 		gt_sync();
 	}
@@ -3,24 +3,120 @@
 // GameTank port of OscarTutorials/0300_Labyrinth.
 // The original generates a maze on the C64 text screen using iterative
 // backtracking (random walk that carves paths and backtracks at dead ends).
-// Here we generate a maze on the 128x128 framebuffer using 4x4 pixel cells,
-// creating a 32x32 grid. Press Start to generate a new maze.
+// Here we generate a 128x64 cell maze with 4x4 pixel cells and show a
+// 32x32 cell window of it, which follows the walk until the d-pad scrolls
+// it. Press A or Start on either gamepad to generate a new maze, even
+// while one is still being carved.
+//
+// Once the maze is done it is solved from the start to the open cell
+// nearest the bottom-right corner: a breadth-first flood spreads from the
+// start (cyan), then the path is traced back from the exit (yellow). B
+// solves again towards the cell in the middle of the window.
+//
+// The walk is resumable: its only state between steps is the current
+// cell, so each frame runs a fixed number of steps and returns. The solver
+// works the same way, a bounded number of cells per frame.
+//
+// A byte per cell would take all of RAM at this size, so each cell keeps
+// an open bit in one bitmap and the 2-bit direction that led to it in
+// another (3KB in total). Border walls follow from the coordinates. The
+// solver adds two more bitmaps and a 128-byte queue.
+//
+// The window lives in the background layer in sprite RAM (gt_bg.h), used
+// as a ring: world cell (x, y) always sits at ((4x) mod 128, (4y) mod 128).
+// Scrolling by a cell only draws the one row or column it uncovers into the
+// ring, and carving only draws the cells that changed. A page is copied to
+// the screen with gt_bg_restore_wrap() only when the ring was drawn into
+// since that page last showed it; once the maze and the solver are done, a
+// still window costs no blits at all.
 
 #include "gt.h"
+#include "gt_bg.h"
 
-#define GRID_W    32
-#define GRID_H    32
+#define GRID_W    128
+#define GRID_H    64
 #define CELL_SIZE 4
 
-// Maze grid: 32x32 cells
-// 0xFF = unvisited, 0xFE = border wall
-// 0-3 = direction that led here (for backtracking)
-// 0xFC = start cell marker
-static byte maze[GRID_W * GRID_H];
+// Window size in cells
+#define VIEW_W    (GT_SCREEN_W / CELL_SIZE)
+#define VIEW_H    (GT_SCREEN_H / CELL_SIZE)
+
+// Walk steps (carves or backtracks) per frame. Each costs at most four
+// maze_check() calls, so this bounds the generator's time per frame.
+#define MAZE_STEPS  16
+
+// Cells the flood takes off its queue, and path cells traced, per frame
+#define SOLVE_STEPS  16
+#define TRACE_STEPS  32
+
+// Queue size of the flood. Its frontier in these mazes stays around ten
+// cells; should it ever fill up, the flood simply stops early.
+#define SOLVE_QUEUE  64
+#define SOLVE_MASK   (SOLVE_QUEUE - 1)
+
+// Cells are numbered p = y * GRID_W + x.
+// maze_open: one bit per cell, set once the cell is carved
+// maze_dir:  two bits per cell, the direction that led here (for
+//            backtracking), valid for carved cells
+static byte maze_open[GRID_W * GRID_H / 8];
+static byte maze_dir[GRID_W * GRID_H / 4];
+
+static const byte cell_bit[8] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80};
 
 // Direction offsets: right, down, left, up
 static const int bdir[4] = {1, GRID_W, -1, -GRID_W};
 
+// Bit of cell p in a one-bit-per-cell map
+static bool cell_test(const byte * bits, unsigned p)
+{
+	return (bits[p >> 3] & cell_bit[p & 7]) != 0;
+}
+
+static void cell_set(byte * bits, unsigned p)
+{
+	bits[p >> 3] |= cell_bit[p & 7];
+}
+
+static bool cell_open(unsigned p)
+{
+	return cell_test(maze_open, p);
+}
+
+static bool cell_border(unsigned p)
+{
+	byte x = (byte)p & (GRID_W - 1);
+	byte y = (byte)(p >> 7);
+	return x == 0 || x == GRID_W - 1 || y == 0 || y == GRID_H - 1;
+}
+
+// Mark cell p carved, reached by moving in direction d
+static void cell_carve(unsigned p, byte d)
+{
+	cell_set(maze_open, p);
+
+	// Constant shifts only; the 6502 does variable ones in a loop
+	byte * b = maze_dir + (p >> 2);
+	switch ((byte)p & 3)
+	{
+	case 0: *b = (*b & 0xFC) | d;        break;
+	case 1: *b = (*b & 0xF3) | (d << 2); break;
+	case 2: *b = (*b & 0xCF) | (d << 4); break;
+	case 3: *b = (*b & 0x3F) | (d << 6); break;
+	}
+}
+
+static byte cell_dir(unsigned p)
+{
+	byte b = maze_dir[p >> 2];
+	switch ((byte)p & 3)
+	{
+	case 0:  return b & 3;
+	case 1:  return (b >> 2) & 3;
+	case 2:  return (b >> 4) & 3;
+	default: return b >> 6;
+	}
+}
+
 // Simple 16-bit LFSR for pseudo-random numbers
 static unsigned lfsr_state = 0xACE1;
 
@@ -34,45 +130,180 @@ static byte maze_rand(void)
 
 // Check if we can carve a path two cells in direction d from position p.
 // The check ensures we don't break into existing corridors.
-static bool maze_check(int p, byte d)
+static bool maze_check(unsigned p, byte d)
 {
-	int p1 = p + bdir[d];
-	int p2 = p1 + bdir[d];
+	unsigned p1 = p + bdir[d];
+	unsigned p2 = p1 + bdir[d];
 	int d0 = bdir[(d + 1) & 3];
 	int d1 = bdir[(d + 3) & 3];
 
 	return
-		maze[p1] == 0xFF &&
-		maze[p1 + d0] >= 0xFE &&
-		maze[p1 + d1] >= 0xFE &&
-		maze[p2] >= 0xFE &&
-		maze[p2 + d0] >= 0xFE &&
-		maze[p2 + d1] >= 0xFE;
+		!cell_open(p1) && !cell_border(p1) &&
+		!cell_open(p1 + d0) &&
+		!cell_open(p1 + d1) &&
+		!cell_open(p2) &&
+		!cell_open(p2 + d0) &&
+		!cell_open(p2 + d1);
+}
+
+// Generator state kept between frames: where the walk started, its head,
+// and whether it is still running
+static unsigned maze_origin;
+static unsigned maze_pos;
+static bool maze_busy;
+
+// Solver state. Every open cell is reachable from the start along exactly
+// one path, so the generator's backtracking directions double as the
+// flood's parent links: the path is traced back along them.
+// solve_seen: cells the flood has reached
+// solve_path: cells of the traced path
+// solve_queue: ring of cells reached but not yet expanded
+static byte solve_seen[GRID_W * GRID_H / 8];
+static byte solve_path[GRID_W * GRID_H / 8];
+static unsigned __striped solve_queue[SOLVE_QUEUE];
+static byte solve_head, solve_tail;
+
+enum SolveState
+{
+	SOLVE_IDLE,
+	SOLVE_FLOOD,
+	SOLVE_TRACE,
+	SOLVE_DONE
+};
+
+static byte solve_state;
+static unsigned solve_exit;
+static unsigned solve_pos;    // Next path cell to trace
+
+// Ring rows still to repaint after the solver's marks were cleared. They
+// count ring rows rather than window rows so that scrolling meanwhile
+// neither skips a row nor repaints one twice.
+static byte solve_repaint;
+
+// Top-left cell of the window, and whether it follows the walk
+static byte cam_x, cam_y;
+static bool cam_follow;
+
+// Bands of the ring still to wipe after a restart; the walk waits for it
+#define WIPE_BAND   16
+static byte view_wipe;
+
+// Pages that do not show the ring as it is now
+static byte view_stale[2];
+
+static void view_touch(void)
+{
+	view_stale[0] = view_stale[1] = 1;
+}
+
+// Draw cell p into the ring if it is inside the window
+static void view_cell(unsigned p)
+{
+	byte x = (byte)p & (GRID_W - 1);
+	byte y = (byte)(p >> 7);
+	if ((byte)(x - cam_x) >= VIEW_W || (byte)(y - cam_y) >= VIEW_H)
+		return;
+
+	byte color = GT_WHITE;
+	if (maze_busy && p == maze_pos)
+		color = GT_RED;
+	else if (!cell_open(p))
+		color = GT_BLUE;
+	else if (solve_state != SOLVE_IDLE && p == solve_exit)
+		color = GT_GREEN;
+	else if (cell_test(solve_path, p))
+		color = GT_YELLOW;
+	else if (cell_test(solve_seen, p))
+		color = GT_CYAN;
+
+	gt_bg_box((byte)(x * CELL_SIZE) & (GT_SCREEN_W - 1),
+	          (byte)(y * CELL_SIZE) & (GT_SCREEN_H - 1),
+	          CELL_SIZE, CELL_SIZE, color);
+	view_touch();
+}
+
+static void view_column(byte x)
+{
+	unsigned p = (unsigned)cam_y * GRID_W + x;
+	for (byte i = 0; i < VIEW_H; i++, p += GRID_W)
+		view_cell(p);
 }
 
-static void maze_build(void)
+static void view_row(byte y)
 {
-	// Fill inner area with 0xFF (unvisited)
-	for (int i = 0; i < GRID_W * GRID_H; i++)
-		maze[i] = 0xFF;
+	unsigned p = (unsigned)y * GRID_W + cam_x;
+	for (byte i = 0; i < VIEW_W; i++, p++)
+		view_cell(p);
+}
 
-	// Set border cells to 0xFE (permanent wall)
-	for (int i = 0; i < GRID_H; i++)
+// Move the window by at most one cell on each axis, drawing what it
+// uncovers into the ring slots the cells that left it had used
+static void view_scroll(signed char dx, signed char dy)
+{
+	if (dx > 0 && cam_x < GRID_W - VIEW_W)
 	{
-		maze[i * GRID_W] = 0xFE;
-		maze[i * GRID_W + GRID_W - 1] = 0xFE;
+		cam_x++;
+		view_column(cam_x + VIEW_W - 1);
 	}
-	for (int i = 0; i < GRID_W; i++)
+	else if (dx < 0 && cam_x > 0)
 	{
-		maze[i] = 0xFE;
-		maze[i + GRID_W * (GRID_H - 1)] = 0xFE;
+		cam_x--;
+		view_column(cam_x);
 	}
 
-	// Start at center
-	int p = (GRID_H / 2) * GRID_W + GRID_W / 2;
-	maze[p] = 0xFC;
+	if (dy > 0 && cam_y < GRID_H - VIEW_H)
+	{
+		cam_y++;
+		view_row(cam_y + VIEW_H - 1);
+	}
+	else if (dy < 0 && cam_y > 0)
+	{
+		cam_y--;
+		view_row(cam_y);
+	}
+}
 
-	for (;;)
+static void solve_clear(void)
+{
+	for (unsigned i = 0; i < sizeof(solve_seen); i++)
+	{
+		solve_seen[i] = 0;
+		solve_path[i] = 0;
+	}
+}
+
+// Reset the grid and start a new walk at the center
+static void maze_start(void)
+{
+	// Nothing carved yet; walls and unvisited cells are both closed
+	for (unsigned i = 0; i < sizeof(maze_open); i++)
+		maze_open[i] = 0;
+
+	maze_origin = (GRID_H / 2) * GRID_W + GRID_W / 2;
+	maze_pos = maze_origin;
+	cell_carve(maze_origin, 0);
+	maze_busy = true;
+
+	// The wipe below repaints the window, so the old marks can go at once
+	solve_clear();
+	solve_state = SOLVE_IDLE;
+	solve_repaint = 0;
+
+	cam_x = GRID_W / 2 - VIEW_W / 2;
+	cam_y = GRID_H / 2 - VIEW_H / 2;
+	cam_follow = true;
+
+	// The ring is repainted as plain wall a band per frame before the
+	// walk starts, instead of stalling for a whole-layer fill
+	view_wipe = GT_SCREEN_H / WIPE_BAND;
+}
+
+// Run up to steps steps of the walk; returns false once the maze is done
+static bool maze_step(byte steps)
+{
+	unsigned p = maze_pos;
+
+	while (steps--)
 	{
 		// Pick a random starting direction and rotation
 		byte d = maze_rand() & 3;
@@ -89,72 +320,238 @@ static void maze_build(void)
 		if (i == 4)
 		{
 			// Dead end — backtrack along the direction that brought us here
-			p -= bdir[maze[p]];
+			p -= bdir[cell_dir(p)];
 
-			if (maze[p] == 0xFC)
+			if (p == maze_origin)
 			{
 				// Back at start — maze is complete
-				maze[p] = 0;
-				return;
+				unsigned head = maze_pos;
+				maze_pos = p;
+				maze_busy = false;
+				view_cell(head);
+				return false;
 			}
 		}
 		else
 		{
 			// Carve path: move to next cell, remember direction for backtracking
 			p += bdir[d];
-			maze[p] = d;
+			cell_carve(p, d);
+			view_cell(p);
+		}
+	}
+
+	// Move the head marker
+	unsigned head = maze_pos;
+	maze_pos = p;
+	view_cell(head);
+	view_cell(p);
+	return true;
+}
+
+// Start solving from the walk's start to cell exit, which must be open
+static void solve_start(unsigned exit)
+{
+	// Marks of an earlier solve go from the bitmaps now and from the
+	// window a row per frame, so no frame has to repaint all of it
+	if (solve_state != SOLVE_IDLE)
+	{
+		solve_clear();
+		solve_repaint = VIEW_H;
+	}
+
+	unsigned old = solve_exit;
+	solve_exit = exit;
+	solve_state = SOLVE_FLOOD;
+	view_cell(old);
+	view_cell(exit);
+
+	cell_set(solve_seen, maze_origin);
+	solve_queue[0] = maze_origin;
+	solve_head = 1;
+	solve_tail = 0;
+	view_cell(maze_origin);
+}
+
+// Expand up to steps cells of the flood, oldest first. Reaching the exit,
+// or running out of queue, hands over to tracing; the path follows from
+// the parent links either way, only the flood stops early.
+static void solve_flood(byte steps)
+{
+	while (steps--)
+	{
+		if (solve_head == solve_tail)
+		{
+			solve_pos = solve_exit;
+			solve_state = SOLVE_TRACE;
+			return;
+		}
+
+		unsigned p = solve_queue[solve_tail];
+		solve_tail = (solve_tail + 1) & SOLVE_MASK;
+		for (byte d = 0; d < 4; d++)
+		{
+			// Border cells are never open, so q stays inside the grid
+			unsigned q = p + bdir[d];
+			if (cell_open(q) && !cell_test(solve_seen, q))
+			{
+				byte next = (solve_head + 1) & SOLVE_MASK;
+				if (q == solve_exit || next == solve_tail)
+				{
+					solve_pos = solve_exit;
+					solve_state = SOLVE_TRACE;
+					return;
+				}
+
+				cell_set(solve_seen, q);
+				solve_queue[solve_head] = q;
+				solve_head = next;
+				view_cell(q);
+			}
 		}
 	}
 }
 
-static void maze_draw(void)
+// Mark up to steps cells of the path, walking from the exit to the start
+static void solve_trace(byte steps)
 {
-	for (byte y = 0; y < GRID_H; y++)
+	unsigned p = solve_pos;
+
+	while (steps--)
 	{
-		for (byte x = 0; x < GRID_W; x++)
+		cell_set(solve_path, p);
+		view_cell(p);
+
+		if (p == maze_origin)
 		{
-			byte val = maze[y * GRID_W + x];
-			byte color = (val >= 0x80) ? GT_BLUE : GT_WHITE;
-			gt_draw_box(x * CELL_SIZE, y * CELL_SIZE, CELL_SIZE, CELL_SIZE, color);
+			solve_state = SOLVE_DONE;
+			return;
 		}
+		p -= bdir[cell_dir(p)];
 	}
+
+	solve_pos = p;
+}
+
+// The open cell nearest the bottom-right corner, in reading order
+static unsigned solve_corner(void)
+{
+	unsigned p = (GRID_H - 1) * GRID_W - 2;
+	while (!cell_open(p))
+		p--;
+	return p;
+}
+
+// No open cell in the window
+#define SOLVE_NONE  0xffff
+
+// The first open cell of the window from its middle on, in reading order
+// and wrapping around to its top, or SOLVE_NONE
+static unsigned solve_middle(void)
+{
+	byte x = VIEW_W / 2, y = VIEW_H / 2;
+	for (unsigned i = 0; i < VIEW_W * VIEW_H; i++)
+	{
+		unsigned p = (unsigned)(cam_y + y) * GRID_W + cam_x + x;
+		if (cell_open(p))
+			return p;
+
+		if (++x == VIEW_W)
+		{
+			x = 0;
+			y = (y + 1) & (VIEW_H - 1);
+		}
+	}
+	return SOLVE_NONE;
 }
 
 int main(void)
 {
 	gt_init();
 
+	maze_start();
+
+	#define REGEN_MASK (INPUT_A | INPUT_START)
+	#define DPAD_MASK  (INPUT_UP | INPUT_DOWN | INPUT_LEFT | INPUT_RIGHT)
+
 	for (;;)
 	{
-		maze_build();
+		// A new press of A or Start on either pad restarts at once
+		if ((gt_pad_pressed(0) | gt_pad_pressed(1)) & REGEN_MASK)
+			maze_start();
 
-		// Draw maze on BOTH framebuffer pages so it's stable
-		gt_clear(GT_BLACK);
-		maze_draw();
-		gt_sync();
-		gt_clear(GT_BLACK);
-		maze_draw();
-		gt_sync();
+		if (view_wipe)
+		{
+			view_wipe--;
+			gt_bg_box(0, view_wipe * WIPE_BAND, GT_SCREEN_W, WIPE_BAND, GT_BLUE);
+			view_touch();
+			if (!view_wipe)
+				view_cell(maze_origin);
+		}
+		else if (maze_busy)
+		{
+			maze_busy = maze_step(MAZE_STEPS);
+			if (!maze_busy)
+				solve_start(solve_corner());
+		}
+		else
+		{
+			if (gt_pad_pressed(0) & INPUT_B)
+			{
+				unsigned p = solve_middle();
+				if (p != SOLVE_NONE)
+					solve_start(p);
+			}
 
-		// Wait for A button or Start to regenerate.
-		// Use gt_wait_vblank() (not gt_sync) to avoid flipping pages.
-		#define REGEN_MASK (INPUT_A | INPUT_START)
+			if (solve_state == SOLVE_FLOOD)
+				solve_flood(SOLVE_STEPS);
+			else if (solve_state == SOLVE_TRACE)
+				solve_trace(TRACE_STEPS);
 
-		// First wait for any current press to release
-		while (gt_read_gamepad() & REGEN_MASK)
-			gt_wait_vblank();
+			// Vary the LFSR based on frames waited (adds randomness)
+			maze_rand();
+		}
 
-		// Then wait for new press
-		for (;;)
+		if (solve_repaint)
 		{
-			unsigned pad = gt_read_gamepad();
-			if (pad & REGEN_MASK)
-				break;
-			gt_wait_vblank();
+			// Ring row r holds the one window row y with y % VIEW_H == r
+			solve_repaint--;
+			view_row(cam_y + ((solve_repaint - cam_y) & (VIEW_H - 1)));
+		}
 
-			// Vary the LFSR based on frames waited (adds randomness)
-			maze_rand();
+		// The d-pad scrolls a cell per frame and stops the window from
+		// following the walk
+		unsigned pad = gt_pad_held(0);
+		signed char dx = 0, dy = 0;
+		if (pad & DPAD_MASK)
+		{
+			cam_follow = false;
+			if (pad & INPUT_LEFT)  dx = -1;
+			if (pad & INPUT_RIGHT) dx = 1;
+			if (pad & INPUT_UP)    dy = -1;
+			if (pad & INPUT_DOWN)  dy = 1;
+		}
+		else if (cam_follow && maze_busy)
+		{
+			// Ease towards centering the head
+			byte hx = (byte)maze_pos & (GRID_W - 1);
+			byte hy = (byte)(maze_pos >> 7);
+			int tx = (int)hx - VIEW_W / 2;
+			int ty = (int)hy - VIEW_H / 2;
+			if (tx > cam_x) dx = 1; else if (tx < cam_x) dx = -1;
+			if (ty > cam_y) dy = 1; else if (ty < cam_y) dy = -1;
 		}
+		view_scroll(dx, dy);
+
+		// Scrolling always draws the cells it uncovers, so the camera
+		// cannot move without marking both pages
+		byte page = gt_draw_page();
+		if (view_stale[page])
+		{
+			gt_bg_restore_wrap(cam_x * CELL_SIZE, cam_y * CELL_SIZE);
+			view_stale[page] = 0;
+		}
+		gt_sync();
 	}
 
 	return 0;
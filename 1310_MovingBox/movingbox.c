@@ -5,6 +5,7 @@
 // Here we move 4 colored boxes that wrap from bottom to top.
 
 #include "gt.h"
+#include "gt_dirty.h"
 
 #define NUM_BOXES 4
 #define BOX_SIZE  12
@@ -25,12 +26,13 @@ int main(void)
 
 	for (;;)
 	{
-		gt_clear(GT_BLACK);
+		// Erase only where this page's boxes were drawn last time
+		gt_dirty_clear(GT_BLACK);
 
 		// Draw and advance each box
 		for (byte i = 0; i < NUM_BOXES; i++)
 		{
-			gt_draw_box(bx[i], by[i], BOX_SIZE, BOX_SIZE, bc[i]);
+			gt_dirty_box(bx[i], by[i], BOX_SIZE, BOX_SIZE, bc[i]);
 
 			// Move downward, wrap at bottom
 			by[i] += 1 + i;
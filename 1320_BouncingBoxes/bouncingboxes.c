@@ -3,74 +3,60 @@
 // GameTank port of OscarTutorials/1320_ReflectingSprite.
 // The original bounces 8 VIC-II sprites with random velocities.
 // Here we bounce 4 colored boxes, reflecting off all four screen edges.
-// Uses 4-bit fixed-point for smooth sub-pixel movement.
+// Uses the 8.8 fixed-point physics kernels from gt_phys.h for smooth
+// sub-pixel movement.
 
 #include "gt.h"
+#include "gt_dirty.h"
+#include "gt_phys.h"
 
 #define NUM_BOXES 4
 #define BOX_SIZE  10
 
-#define FBITS     4
-#define RIGHT_X   ((GT_SCREEN_W - BOX_SIZE - 1) << FBITS)
-#define BOTTOM_Y  ((GT_SCREEN_H - BOX_SIZE - 1) << FBITS)
-
-struct Box
-{
-	int sx, sy;     // position (fixed-point)
-	int vx, vy;     // velocity (fixed-point)
-	byte color;
-};
+#define RIGHT_X   GT_PHYS_MAX_X(BOX_SIZE)
+#define BOTTOM_Y  GT_PHYS_MAX_Y(BOX_SIZE)
 
 int main(void)
 {
 	gt_init();
 
-	struct Box boxes[NUM_BOXES];
+	byte colors[NUM_BOXES];
 
 	// Initialize with varied positions and velocities
-	// Velocities are in fixed-point: 4 = 0.25 px/frame, 8 = 0.5, 16 = 1.0
-	boxes[0].sx = 10 << FBITS;  boxes[0].sy = 20 << FBITS;
-	boxes[0].vx = 10;           boxes[0].vy = 6;
-	boxes[0].color = GT_RED;
+	// Velocities are in 8.8 fixed-point: 64 = 0.25 px/frame, 128 = 0.5, 256 = 1.0
+	gt_phys_init(NUM_BOXES);
 
-	boxes[1].sx = 80 << FBITS;  boxes[1].sy = 10 << FBITS;
-	boxes[1].vx = -7;           boxes[1].vy = 9;
-	boxes[1].color = GT_GREEN;
+	gt_phys_x[0] = 10 << 8;  gt_phys_y[0] = 20 << 8;
+	gt_phys_vx[0] = 160;     gt_phys_vy[0] = 96;
+	colors[0] = GT_RED;
 
-	boxes[2].sx = 50 << FBITS;  boxes[2].sy = 90 << FBITS;
-	boxes[2].vx = 8;            boxes[2].vy = -5;
-	boxes[2].color = GT_CYAN;
+	gt_phys_x[1] = 80 << 8;  gt_phys_y[1] = 10 << 8;
+	gt_phys_vx[1] = -112;    gt_phys_vy[1] = 144;
+	colors[1] = GT_GREEN;
 
-	boxes[3].sx = 30 << FBITS;  boxes[3].sy = 60 << FBITS;
-	boxes[3].vx = -6;           boxes[3].vy = -8;
-	boxes[3].color = GT_YELLOW;
+	gt_phys_x[2] = 50 << 8;  gt_phys_y[2] = 90 << 8;
+	gt_phys_vx[2] = 128;     gt_phys_vy[2] = -80;
+	colors[2] = GT_CYAN;
+
+	gt_phys_x[3] = 30 << 8;  gt_phys_y[3] = 60 << 8;
+	gt_phys_vx[3] = -96;     gt_phys_vy[3] = -128;
+	colors[3] = GT_YELLOW;
 
 	for (;;)
 	{
-		gt_clear(GT_BLACK);
+		// Advance all boxes, then reflect the ones that left the screen.
+		// This runs before drawing, while the last frame's flip is still
+		// pending.
+		gt_phys_integrate();
+		gt_phys_bounce_walls(RIGHT_X, BOTTOM_Y, 0);
+
+		gt_dirty_clear(GT_BLACK);
 
 		for (byte i = 0; i < NUM_BOXES; i++)
 		{
-			// Advance position
-			int nx = boxes[i].sx + boxes[i].vx;
-			int ny = boxes[i].sy + boxes[i].vy;
-
-			// Reflect off left/right edges
-			if (nx < 0 || nx > RIGHT_X)
-				boxes[i].vx = -boxes[i].vx;
-			else
-				boxes[i].sx = nx;
-
-			// Reflect off top/bottom edges
-			if (ny < 0 || ny > BOTTOM_Y)
-				boxes[i].vy = -boxes[i].vy;
-			else
-				boxes[i].sy = ny;
-
-			gt_draw_box(
-				(byte)(boxes[i].sx >> FBITS),
-				(byte)(boxes[i].sy >> FBITS),
-				BOX_SIZE, BOX_SIZE, boxes[i].color);
+			gt_dirty_box(
+				GT_PHYS_PX(i), GT_PHYS_PY(i),
+				BOX_SIZE, BOX_SIZE, colors[i]);
 		}
 
 		gt_sync();
@@ -3,113 +3,113 @@
 // GameTank port of OscarTutorials/1330_CollidingSprite.
 // The original bounces 8 VIC-II sprites and uses hardware sprite-sprite
 // collision detection to change colors on impact.
-// Here we bounce 4 boxes with software AABB collision detection.
+// Here we bounce 64 boxes with software AABB collision detection.
 // Colliding boxes turn yellow; non-colliding boxes show their base color.
+//
+// Testing every pair of 64 boxes would take 2016 overlap tests per frame.
+// Instead the sweep-and-prune broadphase in gt_sweep.h keeps the boxes
+// sorted by X and only tests boxes whose X ranges overlap.
+//
+// The bar along the bottom is the frame profiler: blue = clear, green =
+// physics, orange = draw, gray = waiting in gt_sync(). The white tick marks
+// the end of one 60Hz frame.
 
 #include "gt.h"
+#include "gt_phys.h"
+#include "gt_prof.h"
+#include "gt_sweep.h"
 
-#define NUM_BOXES  4
-#define BOX_SIZE   10
+#define NUM_BOXES  64
+#define BOX_SIZE   6
 
-// 4-bit fixed-point for sub-pixel movement
-#define FBITS      4
-#define RIGHT_X    ((GT_SCREEN_W - BOX_SIZE - 1) << FBITS)
-#define BOTTOM_Y   ((GT_SCREEN_H - BOX_SIZE - 1) << FBITS)
+// Positions and velocities live in gt_phys (8.8 fixed-point)
+#define RIGHT_X    GT_PHYS_MAX_X(BOX_SIZE)
+#define BOTTOM_Y   GT_PHYS_MAX_Y(BOX_SIZE)
 
-struct Box
-{
-	int sx, sy;         // position (fixed-point)
-	int vx, vy;         // velocity (fixed-point)
-	byte base_color;    // normal color
-	byte draw_color;    // color this frame (yellow if colliding)
-};
-
-// AABB overlap test using pixel coordinates
-static bool boxes_overlap(int x1, int y1, int x2, int y2)
+static byte base_color[NUM_BOXES];  // normal color
+static byte draw_color[NUM_BOXES];  // color this frame (yellow if colliding)
+
+static const byte base_colors[4] = {GT_RED, GT_GREEN, GT_CYAN, GT_MAGENTA};
+
+// Broadphase callback: both boxes of an overlapping pair turn yellow
+static void boxes_overlap(byte a, byte b)
 {
-	if (x1 + BOX_SIZE <= x2 || x2 + BOX_SIZE <= x1)
-		return false;
-	if (y1 + BOX_SIZE <= y2 || y2 + BOX_SIZE <= y1)
-		return false;
-	return true;
+	draw_color[a] = GT_YELLOW;
+	draw_color[b] = GT_YELLOW;
 }
 
 int main(void)
 {
 	gt_init();
 
-	struct Box boxes[NUM_BOXES];
-
-	// Initialize with varied positions and velocities
-	boxes[0].sx = 10 << FBITS;  boxes[0].sy = 20 << FBITS;
-	boxes[0].vx = 10;           boxes[0].vy = 6;
-	boxes[0].base_color = GT_RED;
-
-	boxes[1].sx = 80 << FBITS;  boxes[1].sy = 10 << FBITS;
-	boxes[1].vx = -7;           boxes[1].vy = 9;
-	boxes[1].base_color = GT_GREEN;
-
-	boxes[2].sx = 50 << FBITS;  boxes[2].sy = 90 << FBITS;
-	boxes[2].vx = 8;            boxes[2].vy = -5;
-	boxes[2].base_color = GT_CYAN;
+	// Start the boxes on an 8x8 grid with varied velocities
+	// (multiples of 1/16 px/frame between -0.5 and 0.5)
+	gt_phys_init(NUM_BOXES);
+	for (byte i = 0; i < NUM_BOXES; i++)
+	{
+		int vx = (int)((i * 5) & 15) - 8;
+		int vy = (int)((i * 11) & 15) - 8;
+		if (vx == 0)
+			vx = 3;
+		if (vy == 0)
+			vy = -3;
+
+		gt_phys_x[i] = ((i & 7) * 14 + 4) << 8;
+		gt_phys_y[i] = ((i >> 3) * 14 + 4) << 8;
+		gt_phys_vx[i] = vx << 4;
+		gt_phys_vy[i] = vy << 4;
+		base_color[i] = base_colors[i & 3];
+	}
 
-	boxes[3].sx = 30 << FBITS;  boxes[3].sy = 60 << FBITS;
-	boxes[3].vx = -6;           boxes[3].vy = -8;
-	boxes[3].base_color = GT_MAGENTA;
+	gt_sweep_init(NUM_BOXES);
+	gt_prof_init();
 
 	for (;;)
 	{
-		gt_clear(GT_BLACK);
+		// Physics runs first, while the flip requested by the last
+		// gt_prof_sync() is still waiting for vblank
+		gt_prof_begin(GT_PROF_PHYSICS);
 
 		// Advance positions and bounce off walls
+		gt_phys_integrate();
+		gt_phys_bounce_walls(RIGHT_X, BOTTOM_Y, 0);
+
 		for (byte i = 0; i < NUM_BOXES; i++)
 		{
-			int nx = boxes[i].sx + boxes[i].vx;
-			int ny = boxes[i].sy + boxes[i].vy;
+			// Default to base color
+			draw_color[i] = base_color[i];
 
-			if (nx < 0 || nx > RIGHT_X)
-				boxes[i].vx = -boxes[i].vx;
-			else
-				boxes[i].sx = nx;
+			// Hand the pixel bounds to the broadphase
+			gt_sweep_set(i, GT_PHYS_PX(i), GT_PHYS_PY(i), BOX_SIZE, BOX_SIZE);
+		}
 
-			if (ny < 0 || ny > BOTTOM_Y)
-				boxes[i].vy = -boxes[i].vy;
-			else
-				boxes[i].sy = ny;
+		// Report overlapping pairs
+		gt_sweep_pairs(boxes_overlap);
 
-			// Default to base color
-			boxes[i].draw_color = boxes[i].base_color;
-		}
+		gt_prof_end(GT_PROF_PHYSICS);
 
-		// Check all pairs for AABB overlap
-		for (byte i = 0; i < NUM_BOXES; i++)
-		{
-			int px_i = boxes[i].sx >> FBITS;
-			int py_i = boxes[i].sy >> FBITS;
-
-			for (byte j = i + 1; j < NUM_BOXES; j++)
-			{
-				int px_j = boxes[j].sx >> FBITS;
-				int py_j = boxes[j].sy >> FBITS;
-
-				if (boxes_overlap(px_i, py_i, px_j, py_j))
-				{
-					boxes[i].draw_color = GT_YELLOW;
-					boxes[j].draw_color = GT_YELLOW;
-				}
-			}
-		}
+		// With 64 boxes a full clear is cheaper than tracking dirty
+		// rectangles. The zone includes any wait left for the flip.
+		gt_prof_begin(GT_PROF_CLEAR);
+		gt_clear(GT_BLACK);
+		gt_prof_end(GT_PROF_CLEAR);
 
-		// Draw all boxes
+		// Draw all boxes. They share a size, so only position and color
+		// are stored into the zero-page arguments per box.
+		gt_prof_begin(GT_PROF_DRAW);
+		gt_box_w = BOX_SIZE;
+		gt_box_h = BOX_SIZE;
 		for (byte i = 0; i < NUM_BOXES; i++)
 		{
-			gt_draw_box(
-				(byte)(boxes[i].sx >> FBITS),
-				(byte)(boxes[i].sy >> FBITS),
-				BOX_SIZE, BOX_SIZE, boxes[i].draw_color);
+			gt_box_x = GT_PHYS_PX(i);
+			gt_box_y = GT_PHYS_PY(i);
+			gt_box_color = draw_color[i];
+			gt_draw_box_zp();
 		}
+		gt_prof_overlay();
+		gt_prof_end(GT_PROF_DRAW);
 
-		gt_sync();
+		gt_prof_sync();
 	}
 
 	return 0;
@@ -3,101 +3,90 @@
 // GameTank port of OscarTutorials/1350_GravitySprite.
 // The original applies gravity to VIC-II sprites with fixed-point positions.
 // Here we apply gravity to colored boxes that bounce off the floor.
-// Uses 4-bit fixed-point math for sub-pixel precision.
+// Uses the 8.8 fixed-point physics kernels from gt_phys.h for sub-pixel
+// precision.
+//
+// The physics runs at a fixed 60 steps per second with gt_pace.h: when a
+// frame misses a vblank, the next one runs the steps it owes before
+// drawing, so the boxes fall at the same speed however busy the frame is.
 
 #include "gt.h"
+#include "gt_bg.h"
+#include "gt_dirty.h"
+#include "gt_pace.h"
+#include "gt_phys.h"
 
 #define NUM_BOXES 4
 #define BOX_SIZE  8
 
-// 6-bit fixed-point: upper bits = integer, lower 6 bits = fraction
-#define FBITS   6
-#define FONE    (1 << FBITS)
+// Gravity: 1/64 pixel per frame per frame in 8.8 fixed-point
+#define GRAVITY   4
 
-#define FLOOR_Y   ((GT_SCREEN_H - BOX_SIZE - 1) << FBITS)
-#define RIGHT_X   ((GT_SCREEN_W - BOX_SIZE - 1) << FBITS)
+// Each floor bounce keeps 7/8 of the vertical speed (loses 1/2^3)
+#define FLOOR_DAMP 3
 
-struct Box
-{
-	int sx, sy;     // position (fixed-point)
-	int vx, vy;     // velocity (fixed-point)
-	byte color;
-};
+#define FLOOR_Y   GT_PHYS_MAX_Y(BOX_SIZE)
+#define RIGHT_X   GT_PHYS_MAX_X(BOX_SIZE)
 
 int main(void)
 {
 	gt_init();
 
-	struct Box boxes[NUM_BOXES];
+	byte colors[NUM_BOXES];
 
 	// Initialize with varied positions and horizontal velocities
-	boxes[0].sx = 10 << FBITS;  boxes[0].sy = 10 << FBITS;
-	boxes[0].vx = 5;            boxes[0].vy = 0;
-	boxes[0].color = GT_RED;
+	gt_phys_init(NUM_BOXES);
+
+	gt_phys_x[0] = 10 << 8;  gt_phys_y[0] = 10 << 8;
+	gt_phys_vx[0] = 20;      gt_phys_vy[0] = 0;
+	colors[0] = GT_RED;
+
+	gt_phys_x[1] = 80 << 8;  gt_phys_y[1] = 20 << 8;
+	gt_phys_vx[1] = -16;     gt_phys_vy[1] = 0;
+	colors[1] = GT_GREEN;
 
-	boxes[1].sx = 80 << FBITS;  boxes[1].sy = 20 << FBITS;
-	boxes[1].vx = -4;           boxes[1].vy = 0;
-	boxes[1].color = GT_GREEN;
+	gt_phys_x[2] = 40 << 8;  gt_phys_y[2] = 5 << 8;
+	gt_phys_vx[2] = 24;      gt_phys_vy[2] = -16;
+	colors[2] = GT_CYAN;
 
-	boxes[2].sx = 40 << FBITS;  boxes[2].sy = 5 << FBITS;
-	boxes[2].vx = 6;            boxes[2].vy = -4;
-	boxes[2].color = GT_CYAN;
+	gt_phys_x[3] = 100 << 8; gt_phys_y[3] = 30 << 8;
+	gt_phys_vx[3] = -12;     gt_phys_vy[3] = 8;
+	colors[3] = GT_YELLOW;
 
-	boxes[3].sx = 100 << FBITS; boxes[3].sy = 30 << FBITS;
-	boxes[3].vx = -3;           boxes[3].vy = 2;
-	boxes[3].color = GT_YELLOW;
+	// Background with a "floor" line, kept in sprite RAM and painted on
+	// both pages; erasing the boxes copies it back
+	gt_bg_clear(GT_BLACK);
+	gt_bg_box(0, GT_SCREEN_H - 1, 127, 1, GT_DARK_GRAY);
+	gt_bg_restore();
+	gt_flip();
+	gt_bg_restore();
+	gt_flip();
+
+	gt_pace_init(GT_PACE_MAX_STEPS);
 
 	for (;;)
 	{
-		gt_clear(GT_BLACK);
+		// Apply gravity, advance, then bounce off the walls and the
+		// floor, dampening vertical speed on each floor bounce. One step
+		// per vblank since the last frame; this runs before drawing,
+		// while the last frame's flip is still pending.
+		for (byte n = gt_pace_steps(); n; n--)
+		{
+			gt_phys_apply_gravity(GRAVITY);
+			gt_phys_integrate();
+			gt_phys_bounce_walls(RIGHT_X, FLOOR_Y, FLOOR_DAMP);
+		}
 
-		// Draw a "floor" line
-		gt_draw_box(0, GT_SCREEN_H - 1, 127, 1, GT_DARK_GRAY);
+		gt_dirty_restore();
 
 		for (byte i = 0; i < NUM_BOXES; i++)
 		{
-			// Apply gravity to vertical velocity
-			boxes[i].vy += 1;
-
-			// Advance position
-			int nx = boxes[i].sx + boxes[i].vx;
-			int ny = boxes[i].sy + boxes[i].vy;
-
-			// Bounce off left/right walls
-			if (nx < 0 || nx > RIGHT_X)
-			{
-				boxes[i].vx = -boxes[i].vx;
-			}
-			else
-			{
-				boxes[i].sx = nx;
-			}
-
-			// Bounce off floor/ceiling
-			if (ny > FLOOR_Y)
-			{
-				boxes[i].sy = FLOOR_Y;
-				// Reverse and dampen vertical velocity
-				boxes[i].vy = -(boxes[i].vy * 7 / 8);
-			}
-			else if (ny < 0)
-			{
-				boxes[i].sy = 0;
-				boxes[i].vy = -boxes[i].vy;
-			}
-			else
-			{
-				boxes[i].sy = ny;
-			}
-
-			// Convert fixed-point to pixel coordinates and draw
-			gt_draw_box(
-				(byte)(boxes[i].sx >> FBITS),
-				(byte)(boxes[i].sy >> FBITS),
-				BOX_SIZE, BOX_SIZE, boxes[i].color);
+			gt_dirty_box(
+				GT_PHYS_PX(i), GT_PHYS_PY(i),
+				BOX_SIZE, BOX_SIZE, colors[i]);
 		}
 
-		gt_sync();
+		gt_pace_sync();
 	}
 
 	return 0;
@@ -2,70 +2,148 @@
 //
 // GameTank port of OscarTutorials/1500_BitmapPixels.
 // The original draws a spirograph-like parametric curve on a C64 hires
-// bitmap using floating-point sin/cos. Here we draw individual pixels
-// (1x1 boxes) using sine table lookups, building up a Lissajous-like
-// pattern as a scrolling trail.
+// bitmap using floating-point sin/cos. Here we plot individual pixels
+// using sine table lookups, building up a Lissajous-like pattern as a
+// 1024-point trail.
 //
-// Key concept: plotting individual pixels on the framebuffer using the
-// blitter's color fill mode with 1x1 dimensions.
+// Key concept: incremental drawing. The screen is never cleared after
+// startup. Each framebuffer page remembers how much of the trail it
+// already holds, so a frame only plots the points added since that page
+// was last shown, erases the ones that aged out, and recolors the few
+// that crossed the fade boundary. Pixels are written directly from the
+// CPU with gt_plot() rather than as 1x1 blits.
 
 #include "gt.h"
+#include "gt_tables.h"
 
-// Reuse the same sine table as 4250_SineTable
-// sintab[i] = round(40 * sin(i * 2*PI / 256)), range [-40, 40]
-static const signed char sintab[256] = {
-	   0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   13,   14,
-	  15,   16,   17,   18,   19,   20,   21,   21,   22,   23,   24,   25,   25,   26,   27,   28,
-	  28,   29,   30,   30,   31,   32,   32,   33,   33,   34,   34,   35,   35,   36,   36,   37,
-	  37,   37,   38,   38,   38,   39,   39,   39,   39,   39,   40,   40,   40,   40,   40,   40,
-	  40,   40,   40,   40,   40,   40,   40,   39,   39,   39,   39,   39,   38,   38,   38,   37,
-	  37,   37,   36,   36,   35,   35,   34,   34,   33,   33,   32,   32,   31,   30,   30,   29,
-	  28,   28,   27,   26,   25,   25,   24,   23,   22,   21,   21,   20,   19,   18,   17,   16,
-	  15,   14,   13,   13,   12,   11,   10,    9,    8,    7,    6,    5,    4,    3,    2,    1,
-	   0,   -1,   -2,   -3,   -4,   -5,   -6,   -7,   -8,   -9,  -10,  -11,  -12,  -13,  -13,  -14,
-	 -15,  -16,  -17,  -18,  -19,  -20,  -21,  -21,  -22,  -23,  -24,  -25,  -25,  -26,  -27,  -28,
-	 -28,  -29,  -30,  -30,  -31,  -32,  -32,  -33,  -33,  -34,  -34,  -35,  -35,  -36,  -36,  -37,
-	 -37,  -37,  -38,  -38,  -38,  -39,  -39,  -39,  -39,  -39,  -40,  -40,  -40,  -40,  -40,  -40,
-	 -40,  -40,  -40,  -40,  -40,  -40,  -40,  -39,  -39,  -39,  -39,  -39,  -38,  -38,  -38,  -37,
-	 -37,  -37,  -36,  -36,  -35,  -35,  -34,  -34,  -33,  -33,  -32,  -32,  -31,  -30,  -30,  -29,
-	 -28,  -28,  -27,  -26,  -25,  -25,  -24,  -23,  -22,  -21,  -21,  -20,  -19,  -18,  -17,  -16,
-	 -15,  -14,  -13,  -13,  -12,  -11,  -10,   -9,   -8,   -7,   -6,   -5,   -4,   -3,   -2,   -1
-};
-
-#define TRAIL_LEN  128
-
-// Circular buffer for trail positions
-static byte trail_x[TRAIL_LEN];
-static byte trail_y[TRAIL_LEN];
-static byte trail_head;
-static byte trail_count;
+// Sine values come from the shared gt_sin40 table (the same one
+// 4250_SineTable uses): round(40 * sin(i * 2*PI / 256)), range [-40, 40]
+
+#define TRAIL_LEN      1024
+#define TRAIL_FADE     20     // Newest points drawn white, older ones gray
+#define TRAIL_REFRESH  16     // Old points redrawn per frame (see below)
+
+// Circular buffer for trail positions. A page lags the newest point by
+// up to two frames, so the ring keeps a few retired points around for
+// the page that still has to erase them.
+#define TRAIL_RING     (TRAIL_LEN + 4)
+
+static byte trail_x[TRAIL_RING];
+static byte trail_y[TRAIL_RING];
+static unsigned trail_head;    // Slot the next point goes into
+static unsigned trail_count;   // Live points, up to TRAIL_LEN
+
+// What each page held when it was last drawn
+static unsigned page_head[2];
+static unsigned page_count[2];
+static unsigned page_refresh[2];
+static byte page_hx[2], page_hy[2];
+
+// Slot n points before slot s
+static unsigned trail_back(unsigned s, unsigned n)
+{
+	return s >= n ? s - n : s + TRAIL_RING - n;
+}
+
+static void trail_plot(unsigned s, byte color)
+{
+	gt_plot(trail_x[s], trail_y[s], color);
+}
+
+// Plot n consecutive points starting at slot s
+static void trail_run(unsigned s, unsigned n, byte color)
+{
+	while (n--)
+	{
+		trail_plot(s, color);
+		if (++s == TRAIL_RING)
+			s = 0;
+	}
+}
+
+// Bring page p up to date with the trail
+static void trail_draw(byte p)
+{
+	unsigned added = trail_head >= page_head[p]
+		? trail_head - page_head[p]
+		: trail_head + TRAIL_RING - page_head[p];
+
+	// Erase points that dropped off the tail since this page was drawn
+	unsigned removed = page_count[p] + added - trail_count;
+	trail_run(trail_back(page_head[p], page_count[p]), removed, GT_BLACK);
+
+	// Points that crossed the fade boundary turn gray
+	if (trail_count > TRAIL_FADE)
+	{
+		unsigned n = trail_count - TRAIL_FADE;
+		if (n > added)
+			n = added;
+		trail_run(trail_back(trail_head, TRAIL_FADE + n), n, GT_LIGHT_GRAY);
+	}
+
+	// Erasing or recoloring a point also hits any other live point on
+	// the same pixel, and the head marker leaves a hole wherever it
+	// passed over the trail. Redrawing a slice of the trail each frame
+	// repairs those within TRAIL_LEN / TRAIL_REFRESH frames.
+	for (byte i = 0; i < TRAIL_REFRESH; i++)
+	{
+		unsigned age = page_refresh[p];
+		if (age >= trail_count)
+			age = 0;
+		page_refresh[p] = age + 1;
+		trail_plot(trail_back(trail_head, age + 1),
+			age < TRAIL_FADE ? GT_WHITE : GT_LIGHT_GRAY);
+	}
+
+	// New points
+	unsigned n = added < TRAIL_FADE ? added : TRAIL_FADE;
+	trail_run(trail_back(trail_head, n), n, GT_WHITE);
+
+	page_head[p] = trail_head;
+	page_count[p] = trail_count;
+}
 
 int main(void)
 {
 	gt_init();
 
+	// Both pages start black; from here on they are only patched
+	gt_clear(GT_BLACK);
+	gt_flip();
+	gt_clear(GT_BLACK);
+	gt_flip();
+
 	trail_head = 0;
 	trail_count = 0;
+	for (byte p = 0; p < 2; p++)
+	{
+		page_head[p] = 0;
+		page_count[p] = 0;
+		page_refresh[p] = 0;
+		page_hx[p] = 0;
+		page_hy[p] = 0;
+	}
 
 	// Multiple angle accumulators at different frequencies
 	// produce the spirograph effect (like the original's
-	// cos(w) + cos(w*5) + cos(w*13) superposition)
-	byte a1 = 0;   // x component: frequency 1
-	byte a2 = 0;   // x component: frequency 5
-	byte a3 = 0;   // y component: frequency 3
-	byte a4 = 0;   // y component: frequency 7
+	// cos(w) + cos(w*5) + cos(w*13) superposition). The high byte is
+	// the table index; the small fractional steps on the faster terms
+	// make each lap land slightly beside the previous one, so a long
+	// trail sweeps out a band instead of retracing one closed curve.
+	unsigned a1 = 0;   // x component: frequency 1
+	unsigned a2 = 0;   // x component: frequency 5
+	unsigned a3 = 0;   // y component: frequency 3
+	unsigned a4 = 0;   // y component: frequency 7
 
 	for (;;)
 	{
-		gt_clear(GT_BLACK);
-
 		// Compute new point using superposition of sine waves
 		// x = center + sin(a1+90)*30/40 + sin(a2+90)*10/40
 		// y = center + sin(a3)*30/40 + sin(a4)*10/40
-		int px = 64 + (sintab[(a1 + 64) & 0xFF] * 3 / 4)
-		            + (sintab[(a2 + 64) & 0xFF] / 4);
-		int py = 64 + (sintab[a3] * 3 / 4)
-		            + (sintab[a4] / 4);
+		int px = 64 + (gt_sin40[((a1 >> 8) + 64) & 0xFF] * 3 / 4)
+		            + (gt_sin40[((a2 >> 8) + 64) & 0xFF] / 4);
+		int py = 64 + (gt_sin40[a3 >> 8] * 3 / 4)
+		            + (gt_sin40[a4 >> 8] / 4);
 
 		// Clamp to screen
 		if (px < 0) px = 0;
@@ -76,30 +154,29 @@ int main(void)
 		// Add to trail buffer
 		trail_x[trail_head] = (byte)px;
 		trail_y[trail_head] = (byte)py;
-		trail_head = (trail_head + 1) & (TRAIL_LEN - 1);
+		if (++trail_head == TRAIL_RING)
+			trail_head = 0;
 		if (trail_count < TRAIL_LEN)
 			trail_count++;
 
-		// Draw entire trail
-		byte idx = (trail_head - trail_count) & (TRAIL_LEN - 1);
-		for (byte i = 0; i < trail_count; i++)
-		{
-			// Fade color based on age: newer = brighter
-			byte color = (i > trail_count - 20) ? GT_WHITE : GT_LIGHT_GRAY;
-			gt_draw_box(trail_x[idx], trail_y[idx], 2, 2, color);
-			idx = (idx + 1) & (TRAIL_LEN - 1);
-		}
+		byte p = gt_draw_page();
+
+		// Remove this page's old head marker, then patch the trail
+		gt_draw_box(page_hx[p], page_hy[p], 3, 3, GT_BLACK);
+		trail_draw(p);
 
 		// Draw current point larger and in a bright color
 		gt_draw_box((byte)px, (byte)py, 3, 3, GT_YELLOW);
+		page_hx[p] = (byte)px;
+		page_hy[p] = (byte)py;
 
 		gt_sync();
 
 		// Advance angles at different rates for Lissajous effect
-		a1 += 1;
-		a2 += 5;
-		a3 += 3;
-		a4 += 7;
+		a1 += 0x0100;
+		a2 += 0x0503;
+		a3 += 0x0300;
+		a4 += 0x0705;
 	}
 
 	return 0;
@@ -0,0 +1,159 @@
+// 1600_TileScroll — Scroll smoothly over a map of tiles
+//
+// A 32x32 map of 8x8 tiles, four screens in size, scrolled by the d-pad
+// one pixel per frame (two while B is held). A plants or removes a flower
+// on the tile in the middle of the screen.
+//
+// Key concept: tile maps. The map is just one byte per tile. lib/gt_tilemap.h
+// keeps the view in sprite RAM as a ring, so a scroll writes only the pixel
+// columns and rows it uncovers, and copies the ring to the screen in four
+// blits. The first frame fills the whole view and takes a few frames;
+// after that a frame that neither scrolls nor plants costs nothing.
+
+#include "gt.h"
+#include "gt_tilemap.h"
+
+#define MAP_W  32
+#define MAP_H  32
+
+enum Tiles
+{
+	TILE_GRASS,
+	TILE_WATER,
+	TILE_BRICK,
+	TILE_FLOWER,
+	TILE_COUNT
+};
+
+// Tile pixels are raw VRAM values like sprites
+#define G  ((byte)~GT_GREEN)
+#define Y  ((byte)~GT_YELLOW)
+#define B  ((byte)~GT_BLUE)
+#define C  ((byte)~GT_CYAN)
+#define O  ((byte)~GT_ORANGE)
+#define D  ((byte)~GT_DARK_GRAY)
+#define R  ((byte)~GT_RED)
+
+static const byte tiles[TILE_COUNT * 64] = {
+	// Grass
+	G, G, G, G, G, G, G, G,
+	G, G, G, G, G, Y, G, G,
+	G, G, G, G, G, G, G, G,
+	G, Y, G, G, G, G, G, G,
+	G, G, G, G, G, G, G, G,
+	G, G, G, G, G, G, Y, G,
+	G, G, G, Y, G, G, G, G,
+	G, G, G, G, G, G, G, G,
+
+	// Water
+	B, B, B, B, B, B, B, B,
+	B, C, C, B, B, B, B, B,
+	C, B, B, C, B, B, B, C,
+	B, B, B, B, C, C, C, B,
+	B, B, B, B, B, B, B, B,
+	B, B, B, B, B, C, C, B,
+	B, C, B, B, C, B, B, C,
+	C, B, C, C, B, B, B, B,
+
+	// Brick
+	O, O, O, D, O, O, O, O,
+	O, O, O, D, O, O, O, O,
+	O, O, O, D, O, O, O, O,
+	D, D, D, D, D, D, D, D,
+	O, O, O, O, O, O, O, D,
+	O, O, O, O, O, O, O, D,
+	O, O, O, O, O, O, O, D,
+	D, D, D, D, D, D, D, D,
+
+	// Flower
+	G, G, G, G, G, G, G, G,
+	G, G, G, R, G, G, G, G,
+	G, G, R, Y, R, G, G, G,
+	G, G, G, R, G, G, G, G,
+	G, G, G, G, G, G, G, G,
+	G, G, G, G, G, R, G, G,
+	G, G, G, G, R, Y, R, G,
+	G, G, G, G, G, R, G, G
+};
+
+#undef G
+#undef Y
+#undef B
+#undef C
+#undef O
+#undef D
+#undef R
+
+static byte map[MAP_W * MAP_H];
+
+// Grass inside a brick wall, crossed by a winding river, with flowers
+// scattered by a small LFSR
+static void map_build(void)
+{
+	unsigned seed = 0xACE1;
+
+	for (byte ty = 0; ty < MAP_H; ty++)
+	{
+		// The river drifts one tile sideways every four rows
+		byte river = 10 + ((ty >> 2) & 3);
+
+		for (byte tx = 0; tx < MAP_W; tx++)
+		{
+			seed = (seed >> 1) ^ (-(seed & 1) & 0xB400);
+
+			byte t = TILE_GRASS;
+			if (tx == 0 || ty == 0 || tx == MAP_W - 1 || ty == MAP_H - 1)
+				t = TILE_BRICK;
+			else if (tx == river || tx == river + 1)
+				t = TILE_WATER;
+			else if (!(seed & 15))
+				t = TILE_FLOWER;
+
+			map[ty * MAP_W + tx] = t;
+		}
+	}
+}
+
+int main(void)
+{
+	gt_init();
+
+	gt_tilemap_tiles(tiles);
+	map_build();
+	gt_tilemap_init(map, MAP_W, MAP_H);
+
+	unsigned sx = 0, sy = 0;
+	const unsigned max_x = MAP_W * GT_TILE_SIZE - GT_SCREEN_W;
+	const unsigned max_y = MAP_H * GT_TILE_SIZE - GT_SCREEN_H;
+
+	for (;;)
+	{
+		unsigned pad = gt_pad_held(0);
+		byte speed = (pad & INPUT_B) ? 2 : 1;
+
+		if (pad & INPUT_LEFT)
+			sx = sx > speed ? sx - speed : 0;
+		if (pad & INPUT_RIGHT)
+			sx = sx + speed < max_x ? sx + speed : max_x;
+		if (pad & INPUT_UP)
+			sy = sy > speed ? sy - speed : 0;
+		if (pad & INPUT_DOWN)
+			sy = sy + speed < max_y ? sy + speed : max_y;
+
+		if (gt_pad_pressed(0) & INPUT_A)
+		{
+			byte tx = (sx + GT_SCREEN_W / 2) >> 3;
+			byte ty = (sy + GT_SCREEN_H / 2) >> 3;
+			byte t = gt_tilemap_get(tx, ty);
+			if (t == TILE_GRASS)
+				gt_tilemap_set(tx, ty, TILE_FLOWER);
+			else if (t == TILE_FLOWER)
+				gt_tilemap_set(tx, ty, TILE_GRASS);
+		}
+
+		gt_tilemap_draw(sx, sy);
+		gt_sync();
+	}
+
+	return 0;
+}
@@ -0,0 +1,129 @@
+// 1700_RomAssets — Streaming pictures and sprites from banked ROM
+//
+// The program lives in the last 16KB bank of the 2MB cartridge; the rest is
+// reached one 16KB bank at a time through the window at $8000. build.sh
+// writes this tutorial's rom.bin over the start of the cartridge, and the
+// program streams it out with the gt_asset_* calls:
+//
+//   $2000  picture 0, 128x128 VRAM values (crosses from bank 0 into 1)
+//   $6000  picture 1, 128x128 VRAM values (crosses from bank 1 into 2)
+//   $A000  sprite sheet, four 16x16 frames stacked vertically, 0 = clear
+//   $A400  path, 32 waypoints as (x, y) byte pairs
+//
+// Pictures go into the background layer of gt_bg.h, the sheet into sprite
+// RAM, and the path into RAM two bytes at a time, which the asset's
+// read-ahead buffer turns into four bank switches instead of sixty-four.
+// Every call maps the program's own bank back before returning.
+//
+// Press A to swap pictures; streaming 16KB from ROM takes a few frames.
+
+#include "gt.h"
+#include "gt_bg.h"
+#include "gt_dirty.h"
+
+#define ASSET_BANK      0
+#define PICTURE_OFFSET  0x2000
+#define PICTURE_STRIDE  0x4000
+#define SHEET_OFFSET    0xA000
+#define PATH_OFFSET     0xA400
+
+#define SPRITE_SIZE     16
+#define SPRITE_FRAMES   4
+#define SHEET_GX        0
+#define SHEET_GY        0
+
+#define PATH_POINTS     32
+
+// Frames the sprite takes from one waypoint to the next (a power of two)
+#define SEGMENT_STEPS   16
+#define SEGMENT_SHIFT   4
+
+static byte path_x[PATH_POINTS];
+static byte path_y[PATH_POINTS];
+
+static void load_path(void)
+{
+	struct GTAsset a;
+	gt_asset_open(&a, ASSET_BANK, PATH_OFFSET, PATH_POINTS * 2);
+
+	for (byte i = 0; i < PATH_POINTS; i++)
+	{
+		byte xy[2];
+		gt_asset_read(&a, xy, 2);
+		path_x[i] = xy[0];
+		path_y[i] = xy[1];
+	}
+}
+
+static void load_sheet(void)
+{
+	struct GTAsset a;
+	gt_asset_open(&a, ASSET_BANK, SHEET_OFFSET, SPRITE_SIZE * SPRITE_SIZE * SPRITE_FRAMES);
+	gt_sprite_upload_asset(&a, SHEET_GX, SHEET_GY, SPRITE_SIZE, SPRITE_SIZE * SPRITE_FRAMES);
+}
+
+static void load_picture(byte i)
+{
+	struct GTAsset a;
+	gt_asset_open(&a, ASSET_BANK, PICTURE_OFFSET + i * PICTURE_STRIDE, GT_SCREEN_W * GT_SCREEN_H);
+	gt_sprite_upload_asset(&a, GT_BG_GX, GT_BG_GY, GT_SCREEN_W, GT_SCREEN_H);
+}
+
+// Linear step from a to b, t of SEGMENT_STEPS of the way
+static byte lerp(byte a, byte b, byte t)
+{
+	return (byte)(a + (((int)b - a) * t >> SEGMENT_SHIFT));
+}
+
+int main(void)
+{
+	gt_init();
+
+	load_path();
+	load_sheet();
+
+	byte picture = 0;
+	load_picture(picture);
+
+	// Pages still showing the previous picture
+	byte repaint = 2;
+
+	byte point = 0, step = 0;
+	byte frame = 0;
+
+	for (;;)
+	{
+		if (gt_pad_pressed(0) & INPUT_A)
+		{
+			picture ^= 1;
+			load_picture(picture);
+			repaint = 2;
+		}
+
+		gt_dirty_restore();
+		if (repaint)
+		{
+			gt_bg_restore();
+			repaint--;
+		}
+
+		byte next = (point + 1) & (PATH_POINTS - 1);
+		byte x = lerp(path_x[point], path_x[next], step);
+		byte y = lerp(path_y[point], path_y[next], step);
+		byte gy = SHEET_GY + ((frame >> 2) & (SPRITE_FRAMES - 1)) * SPRITE_SIZE;
+
+		gt_dirty_mark(x, y, SPRITE_SIZE, SPRITE_SIZE);
+		gt_blit_sprite(x, y, SHEET_GX, gy, SPRITE_SIZE, SPRITE_SIZE, 0);
+
+		gt_sync();
+
+		frame++;
+		if (++step == SEGMENT_STEPS)
+		{
+			step = 0;
+			point = next;
+		}
+	}
+
+	return 0;
+}
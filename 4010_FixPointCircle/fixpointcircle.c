@@ -4,99 +4,141 @@
 // The original demonstrates fixed-point arithmetic by rotating a 2D vector.
 // Here we use the same technique to draw boxes arranged in a circle,
 // animating them by rotating the pattern each frame.
+//
+// Multiplies go through gt_fixmath.h, which builds them from byte
+// products looked up in a quarter-square table instead of a 32-bit
+// software multiply.
+//
+// Key concept: a persistent rotor. One 8.8 unit vector holds the
+// pattern's current angle and is rotated by a small step once per frame,
+// so the work per frame does not depend on how far the pattern has
+// turned. Each step slightly lengthens the vector and rounding adds
+// noise, so every few frames it is scaled back to unit length with an
+// inverse square root looked up from its squared length.
 
 #include "gt.h"
+#include "gt_fixmath.h"
+#include "gt_tables.h"
 
 // 8-bit fixed-point (8 integer bits, 8 fraction bits)
-#define FBITS    8
-#define FONE     (1 << FBITS)
-#define FHALF    (FONE / 2)
-
-// Fixed-point multiply: (a * b) >> FBITS
-#define FMUL(a, b) ((int)((long)(a) * (long)(b) >> FBITS))
+#define FONE     GT_FIX_ONE
 
-// Number of boxes to draw around the circle
-#define NUM_POINTS 12
+// Number of boxes to draw around the circle. Must be a multiple of 4
+// that divides 256 (see below).
+#define NUM_POINTS 32
+#define QUARTER    (NUM_POINTS / 4)
 
 // Box size for each point on the circle
 #define BOX_SIZE   6
 
-// Circle radius in pixels
+// Circle radius in pixels. The point offsets come from gt_sin40, whose
+// amplitude is the radius.
 #define RADIUS     40
 
 // Center of screen
 #define CX  (GT_SCREEN_W / 2 - BOX_SIZE / 2)
 #define CY  (GT_SCREEN_H / 2 - BOX_SIZE / 2)
 
-// Step angle: full circle / NUM_POINTS, in fixed-point radians
-// 2*PI ~= 6.283; 6.283 / 12 ~= 0.5236; 0.5236 * 256 ~= 134
-#define ANGLE_STEP 134
+// Rotor step per frame, sin of the step angle in 8.8:
+// 6 / 256 radians ~= 1.3 degrees, about 4.5 seconds per turn
+#define ROTOR_STEP 6
+
+// Frames between renormalizations (must be a power of two)
+#define RENORM_INTERVAL 4
+
+// Where each page drew its boxes, so they can be erased two frames later
+static byte old_x[2][NUM_POINTS];
+static byte old_y[2][NUM_POINTS];
+
+static void draw_point(byte p, byte j, int ox, int oy)
+{
+	int px = CX + ox;
+	int py = CY + oy;
+
+	// Clamp to screen bounds
+	if (px < 0) px = 0;
+	if (px > GT_SCREEN_W - BOX_SIZE - 1) px = GT_SCREEN_W - BOX_SIZE - 1;
+	if (py < 0) py = 0;
+	if (py > GT_SCREEN_H - BOX_SIZE - 1) py = GT_SCREEN_H - BOX_SIZE - 1;
+
+	old_x[p][j] = (byte)px;
+	old_y[p][j] = (byte)py;
+
+	// Alternate colors for visual interest
+	byte color = (j & 1) ? GT_YELLOW : GT_WHITE;
+	gt_draw_box((byte)px, (byte)py, BOX_SIZE, BOX_SIZE, color);
+}
 
 int main(void)
 {
 	gt_init();
 
-	// Angle offset for animation (incremented each frame)
-	int angle_offset = 0;
+	// Paint the background on both pages once; after that only the areas
+	// the boxes covered are erased
+	gt_clear(GT_BLUE);
+	gt_flip();
+	gt_clear(GT_BLUE);
+	gt_flip();
 
-	// Pre-stepped unit vectors: start at (1.0, 0.0) in fixed-point
-	// We'll recompute positions each frame by rotating step-by-step
-
-	for (;;)
+	for (byte j = 0; j < NUM_POINTS; j++)
 	{
-		gt_clear(GT_BLUE);
+		old_x[0][j] = old_x[1][j] = CX;
+		old_y[0][j] = old_y[1][j] = CY;
+	}
 
-		// Start vector at angle_offset: rotate (FONE, 0) by angle_offset steps
-		int ux = FONE;     // cos(0) = 1.0
-		int uy = 0;        // sin(0) = 0.0
+	// The rotor: start at (1.0, 0.0) in fixed-point
+	gt_fix ux = FONE;
+	gt_fix uy = 0;
 
-		// Pre-rotate by angle_offset small steps to set starting angle
-		// Step size for the offset rotation: same as ANGLE_STEP but smaller
-		// We use 1/256 of a circle per offset tick
-		// ds ~= 2*PI/256 * 256 = ~6.28 -> ds_fixed = 6
-		for (int a = 0; a < angle_offset; a++)
+	byte frame = 0;
+
+	for (;;)
+	{
+		// Erase this page's boxes from two frames ago
+		byte p = gt_draw_page();
+		for (byte j = 0; j < NUM_POINTS; j++)
+			gt_draw_box(old_x[p][j], old_y[p][j], BOX_SIZE, BOX_SIZE, GT_BLUE);
+
+		// Point i sits at the rotor angle plus i * 256 / NUM_POINTS in
+		// table units; rotating the rotor by that angle with the table's
+		// cos and sin yields the offset in pixels directly. Turning a
+		// vector by 90 degrees is just (x, y) -> (-y, x), so only the
+		// first quarter of the points needs multiplies.
+		for (byte i = 0; i < QUARTER; i++)
 		{
-			int dx = FMUL(6, -uy);
-			int dy = FMUL(6, ux);
-			ux += dx;
-			uy += dy;
-		}
+			byte a = i * (256 / NUM_POINTS);
+			signed char c = gt_sin40[(byte)(a + 64)];
+			signed char s = gt_sin40[a];
 
-		// Normalize length — after many rotations the vector drifts.
-		// Simple approximation: scale back toward unit length.
-		// |v|^2 in fixed-point; target is FONE^2 = 1<<16
-		// Skip normalization for simplicity — drift is slow enough
-		// for a visual demo over ~256 frames before reset.
+			int ox = gt_fix_sscale(ux, c) - gt_fix_sscale(uy, s);
+			int oy = gt_fix_sscale(ux, s) + gt_fix_sscale(uy, c);
 
-		// Now draw NUM_POINTS boxes equally spaced around the circle
-		for (byte i = 0; i < NUM_POINTS; i++)
-		{
-			// Convert unit vector to screen coordinates
-			int px = CX + FMUL(RADIUS << FBITS, ux) / FONE;
-			int py = CY + FMUL(RADIUS << FBITS, uy) / FONE;
-
-			// Clamp to screen bounds
-			if (px < 0) px = 0;
-			if (px > GT_SCREEN_W - BOX_SIZE - 1) px = GT_SCREEN_W - BOX_SIZE - 1;
-			if (py < 0) py = 0;
-			if (py > GT_SCREEN_H - BOX_SIZE - 1) py = GT_SCREEN_H - BOX_SIZE - 1;
-
-			// Alternate colors for visual interest
-			byte color = (i & 1) ? GT_YELLOW : GT_WHITE;
-			gt_draw_box((byte)px, (byte)py, BOX_SIZE, BOX_SIZE, color);
-
-			// Rotate unit vector by one step (2*PI / NUM_POINTS)
-			int dx = FMUL(ANGLE_STEP, -uy);
-			int dy = FMUL(ANGLE_STEP, ux);
-			ux += dx;
-			uy += dy;
+			draw_point(p, i,               ox,  oy);
+			draw_point(p, i + QUARTER,    -oy,  ox);
+			draw_point(p, i + 2 * QUARTER, -ox, -oy);
+			draw_point(p, i + 3 * QUARTER,  oy, -ox);
 		}
 
 		gt_sync();
 
-		angle_offset++;
-		if (angle_offset >= 128)
-			angle_offset = 0;
+		// Advance the rotor by one step: (x, y) += step * (-y, x).
+		// Both terms use the old vector, which grows the length by a
+		// factor of sqrt(1 + step^2) per frame.
+		int dx = -gt_fix_scale(uy, ROTOR_STEP);
+		int dy = gt_fix_scale(ux, ROTOR_STEP);
+		ux += dx;
+		uy += dy;
+
+		// Scale back to unit length. |u|^2 stays close to 1.0, well
+		// inside the table's [0, 2.0) range.
+		frame++;
+		if (!(frame & (RENORM_INTERVAL - 1)))
+		{
+			unsigned len2 = gt_fix_mul(ux, ux) + gt_fix_mul(uy, uy);
+			gt_fix k = gt_rsqrt[len2];
+			ux = gt_fix_mul(ux, k);
+			uy = gt_fix_mul(uy, k);
+		}
 	}
 
 	return 0;
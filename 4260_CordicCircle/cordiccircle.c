@@ -4,10 +4,19 @@
 // The original uses the CORDIC algorithm (COordinate Rotation DIgital
 // Computer) to compute sine and cosine using only shifts and adds —
 // no multiplication or lookup tables needed. Here we use the same
-// algorithm to move a box in a circle, just like the SineTable tutorial
-// but with on-the-fly computation.
+// algorithm to move a ring of boxes in a circle, just like the SineTable
+// tutorial but with on-the-fly computation.
+//
+// Key concept: a batched, unrolled kernel. The 65C02 can only shift one
+// bit at a time, so "dx >> i" with a variable i is a loop inside a loop.
+// Unrolling the iterations makes every shift count a constant, and
+// processing a whole array of angles per call pays the call overhead
+// once per frame instead of once per object.
 
 #include "gt.h"
+#include "gt_bg.h"
+#include "gt_dirty.h"
+#include "gt_tables.h"
 
 #define BOX_SIZE   6
 #define RADIUS     40
@@ -15,91 +24,141 @@
 #define CX  (GT_SCREEN_W / 2 - BOX_SIZE / 2)
 #define CY  (GT_SCREEN_H / 2 - BOX_SIZE / 2)
 
-// CORDIC arctangent table: atan(2^-i) scaled to 16-bit angle units
-// where 32768 = PI (full circle = 65536 units)
-static const int cordic_atan[8] = {8192, 4836, 2555, 1297, 651, 326, 163, 81};
-
-// Compute sine and cosine using CORDIC algorithm.
-// Input:  w = angle in 16-bit units (0..65535 = 0..2*PI)
-// Output: *si = sine, *co = cosine, both in range [-40, 40] approx
-static void cordic_sincos(int w, signed char *si, signed char *co)
-{
-	// Start with a pre-scaled unit vector.
-	// The CORDIC gain after 8 iterations is K ~= 1.6468.
-	// The output magnitude is start * K, then >>8 for the final value.
-	// For output range [-40, 40]: start = 40 * 256 / K = 10240 / 1.6468 ~= 6218
-	int dx = 6218;
-	int dy = 0;
-
-	// If angle is in the second or third quadrant, flip to first/fourth
-	if (w > 16384 || w < -16384)
-	{
-		w ^= (int)0x8000;
-		dx = -dx;
+// Boxes in the ring, spaced evenly
+#define NUM_BOXES  8
+
+// CORDIC iterations: 8, 12 or 16. Each one adds about a bit of angular
+// precision; with a 16-bit vector the results stop improving after ~14.
+#define CORDIC_ITERS  12
+
+// 1 returns sine and cosine in 8.8 fixed point (RADIUS * 256 = 1.0 *
+// RADIUS) for sub-pixel motion, 0 returns whole pixels.
+#define CORDIC_SUBPIXEL  1
+
+// The arctangent table gt_cordic_atan[i] = atan(2^-i), in 16-bit angle
+// units where 32768 = PI (full circle = 65536 units), is generated at
+// build time into lib/gt_tables.c.
+
+// Start with a pre-scaled vector. Every iteration lengthens the vector,
+// by a total gain K ~= 1.64676 after 8 or more iterations. The output
+// magnitude is start * K, so for RADIUS in 8.8: start = RADIUS * 256 / K.
+#define CORDIC_START  ((int)(RADIUS * 256L * 100000L / 164676L))
+
+// One iteration with a constant shift: rotate by +-atan(2^-i) toward w == 0
+#define CORDIC_STEP(i)                   \
+	{                                    \
+		int sx = dx >> (i);              \
+		int sy = dy >> (i);              \
+		if (w > 0)                       \
+		{                                \
+			dx -= sy;                    \
+			dy += sx;                    \
+			w -= gt_cordic_atan[i];      \
+		}                                \
+		else                             \
+		{                                \
+			dx += sy;                    \
+			dy -= sx;                    \
+			w += gt_cordic_atan[i];      \
+		}                                \
 	}
 
-	// 8 CORDIC iterations — each rotates by atan(2^-i)
-	for (byte i = 0; i < 8; i++)
+// Compute sine and cosine of n angles in one pass.
+// Input:  angles[k] in 16-bit units (0..65535 = 0..2*PI)
+// Output: si[k] = RADIUS * sin, co[k] = RADIUS * cos, in 8.8 fixed point
+//         when CORDIC_SUBPIXEL is set, whole pixels otherwise
+static void cordic_sincos_n(const int * angles, int * si, int * co, byte n)
+{
+	for (byte k = 0; k < n; k++)
 	{
-		int sx = dx >> i;
-		int sy = dy >> i;
+		int w = angles[k];
+		int dx = CORDIC_START;
+		int dy = 0;
 
-		if (w > 0)
-		{
-			// Rotate forward (counter-clockwise)
-			dx += sy;
-			dy -= sx;
-			w -= cordic_atan[i];
-		}
-		else
+		// If angle is in the second or third quadrant, flip to first/fourth
+		if (w > 16384 || w < -16384)
 		{
-			// Rotate backward (clockwise)
-			dx -= sy;
-			dy += sx;
-			w += cordic_atan[i];
+			w ^= (int)0x8000;
+			dx = -dx;
 		}
-	}
 
-	// Return MSBs as approximate sine and cosine
-	*si = (signed char)(dy >> 8);
-	*co = (signed char)(dx >> 8);
+		CORDIC_STEP(0)  CORDIC_STEP(1)  CORDIC_STEP(2)  CORDIC_STEP(3)
+		CORDIC_STEP(4)  CORDIC_STEP(5)  CORDIC_STEP(6)  CORDIC_STEP(7)
+#if CORDIC_ITERS > 8
+		CORDIC_STEP(8)  CORDIC_STEP(9)  CORDIC_STEP(10) CORDIC_STEP(11)
+#endif
+#if CORDIC_ITERS > 12
+		CORDIC_STEP(12) CORDIC_STEP(13) CORDIC_STEP(14) CORDIC_STEP(15)
+#endif
+
+#if CORDIC_SUBPIXEL
+		si[k] = dy;
+		co[k] = dx;
+#else
+		si[k] = dy >> 8;
+		co[k] = dx >> 8;
+#endif
+	}
 }
 
+static int ring_angle[NUM_BOXES];
+static int ring_sin[NUM_BOXES];
+static int ring_cos[NUM_BOXES];
+
 int main(void)
 {
 	gt_init();
 
-	// 8-bit angle — wraps at 256 = full circle
-	byte angle = 0;
+	// Build the background, crosshair included, in sprite RAM and paint
+	// it on both pages once; after that only the areas the boxes covered
+	// are copied back from it
+	gt_bg_clear(GT_BLUE);
+	gt_bg_box(CX + BOX_SIZE / 2 - 1, CY - 8, 2, 16 + BOX_SIZE, GT_DARK_GRAY);
+	gt_bg_box(CX - 8, CY + BOX_SIZE / 2 - 1, 16 + BOX_SIZE, 2, GT_DARK_GRAY);
+	gt_bg_restore();
+	gt_flip();
+	gt_bg_restore();
+	gt_flip();
+
+	// 16-bit angle — wraps at 65536 = full circle. Stepping by less than
+	// 256 units per frame is where the sub-pixel results pay off.
+	unsigned angle = 0;
 
 	for (;;)
 	{
-		gt_clear(GT_BLUE);
-
-		signed char sx, sy;
-
-		// Compute sine and cosine via CORDIC
-		// Shift angle left 8 bits to get 16-bit angle units
-		cordic_sincos((int)angle << 8, &sx, &sy);
+		// Compute the whole ring's sines and cosines in one call, while
+		// the last frame's flip is still pending
+		for (byte i = 0; i < NUM_BOXES; i++)
+			ring_angle[i] = (int)(angle + i * (65536L / NUM_BOXES));
+		cordic_sincos_n(ring_angle, ring_sin, ring_cos, NUM_BOXES);
 
-		// Draw crosshair at center
-		gt_draw_box(CX + BOX_SIZE / 2 - 1, CY - 8, 2, 16 + BOX_SIZE, GT_DARK_GRAY);
-		gt_draw_box(CX - 8, CY + BOX_SIZE / 2 - 1, 16 + BOX_SIZE, 2, GT_DARK_GRAY);
+		gt_dirty_restore();
 
-		// Clamp to screen bounds (CORDIC can slightly overshoot)
-		int px = CX + sx;
-		int py = CY + sy;
-		if (px < 0) px = 0;
-		if (px > GT_SCREEN_W - BOX_SIZE) px = GT_SCREEN_W - BOX_SIZE;
-		if (py < 0) py = 0;
-		if (py > GT_SCREEN_H - BOX_SIZE) py = GT_SCREEN_H - BOX_SIZE;
-
-		// Draw box at computed position
-		gt_draw_box((byte)px, (byte)py, BOX_SIZE, BOX_SIZE, GT_WHITE);
+		for (byte i = 0; i < NUM_BOXES; i++)
+		{
+#if CORDIC_SUBPIXEL
+			// Round 8.8 to the nearest pixel
+			int px = CX + ((ring_cos[i] + 128) >> 8);
+			int py = CY + ((ring_sin[i] + 128) >> 8);
+#else
+			int px = CX + ring_cos[i];
+			int py = CY + ring_sin[i];
+#endif
+
+			// Clamp to screen bounds (CORDIC can slightly overshoot)
+			if (px < 0) px = 0;
+			if (px > GT_SCREEN_W - BOX_SIZE) px = GT_SCREEN_W - BOX_SIZE;
+			if (py < 0) py = 0;
+			if (py > GT_SCREEN_H - BOX_SIZE) py = GT_SCREEN_H - BOX_SIZE;
+
+			// Draw box at computed position
+			byte color = (i & 1) ? GT_YELLOW : GT_WHITE;
+			gt_dirty_box((byte)px, (byte)py, BOX_SIZE, BOX_SIZE, color);
+		}
 
 		gt_sync();
 
-		angle++;
+		angle += 96;
 	}
 
 	return 0;
@@ -0,0 +1,192 @@
+// 4270_DualCore — Sharing work with the audio coprocessor
+//
+// The ring of boxes from 4260_CordicCircle, twice as dense, with every
+// frame's sines and cosines computed twice: first by the main CPU alone,
+// then split between the main CPU and the audio coprocessor running the
+// gt_acp.h worker. The bars at the top show how long each took, one pixel
+// per 512 cycles: white = main CPU alone, green = both CPUs (posting the
+// job, waiting for it and reading the results back included). The yellow
+// bar shows how many of the angles the coprocessor takes, and the gray
+// tick marks a whole frame.
+//
+// Key concept: a second core that runs at a different speed. The main
+// CPU's kernel is unrolled, the coprocessor's is a compact loop, so an
+// even split would leave the main CPU waiting. After every frame the split
+// moves one angle toward whichever side finished first, and settles where
+// both finish together.
+//
+// The boxes are drawn from the two-core results; a red square in the top
+// right corner would mean they differ from the single-core ones.
+
+#include "gt.h"
+#include "gt_acp.h"
+#include "gt_bg.h"
+#include "gt_dirty.h"
+#include "gt_prof.h"
+#include "gt_tables.h"
+
+#define BOX_SIZE   4
+#define RADIUS     40
+
+#define CX  (GT_SCREEN_W / 2 - BOX_SIZE / 2)
+#define CY  (GT_SCREEN_H / 2 + 8 - BOX_SIZE / 2)
+
+// Boxes in the ring, spaced evenly
+#define NUM_BOXES  16
+
+// Both CPUs must run the same number of iterations for identical results
+#define CORDIC_ITERS  12
+
+// Pre-scaled start vector, so the results are RADIUS in 8.8 fixed point
+#define CORDIC_START  ((int)(RADIUS * 256L * 100000L / 164676L))
+
+// Profiler zones for the two runs
+#define ZONE_SINGLE  4
+#define ZONE_DUAL    5
+
+// Timing bars
+#define BAR_Y      2
+#define BAR_H      4
+#define STRIP_H    (3 * (BAR_H + 2))
+
+// One iteration with a constant shift: rotate by +-atan(2^-i) toward w == 0
+#define CORDIC_STEP(i)                   \
+	{                                    \
+		int sx = dx >> (i);              \
+		int sy = dy >> (i);              \
+		if (w > 0)                       \
+		{                                \
+			dx -= sy;                    \
+			dy += sx;                    \
+			w -= gt_cordic_atan[i];      \
+		}                                \
+		else                             \
+		{                                \
+			dx += sy;                    \
+			dy -= sx;                    \
+			w += gt_cordic_atan[i];      \
+		}                                \
+	}
+
+// The main CPU's kernel, as in 4260_CordicCircle: sine and cosine of n
+// angles, RADIUS in 8.8 fixed point
+static void cordic_sincos_n(const int * angles, int * si, int * co, byte n)
+{
+	for (byte k = 0; k < n; k++)
+	{
+		int w = angles[k];
+		int dx = CORDIC_START;
+		int dy = 0;
+
+		if (w > 16384 || w < -16384)
+		{
+			w ^= (int)0x8000;
+			dx = -dx;
+		}
+
+		CORDIC_STEP(0)  CORDIC_STEP(1)  CORDIC_STEP(2)  CORDIC_STEP(3)
+		CORDIC_STEP(4)  CORDIC_STEP(5)  CORDIC_STEP(6)  CORDIC_STEP(7)
+		CORDIC_STEP(8)  CORDIC_STEP(9)  CORDIC_STEP(10) CORDIC_STEP(11)
+
+		si[k] = dy;
+		co[k] = dx;
+	}
+}
+
+static int ring_angle[NUM_BOXES];
+static int single_sin[NUM_BOXES], single_cos[NUM_BOXES];
+static int dual_sin[NUM_BOXES], dual_cos[NUM_BOXES];
+
+// Angles handed to the coprocessor, from the end of the array
+static byte acp_share = NUM_BOXES / 2;
+
+// Bar length for a cycle count, clipped to the screen
+static byte bar_len(unsigned cycles)
+{
+	unsigned len = (cycles >> GT_PROF_SHIFT) + 1;
+	return len > GT_SCREEN_W - 4 ? GT_SCREEN_W - 4 : (byte)len;
+}
+
+int main(void)
+{
+	gt_init();
+	gt_acp_init();
+	gt_prof_init();
+
+	gt_bg_clear(GT_BLUE);
+	gt_bg_box(CX + BOX_SIZE / 2 - 1, CY - 8, 2, 16 + BOX_SIZE, GT_DARK_GRAY);
+	gt_bg_box(CX - 8, CY + BOX_SIZE / 2 - 1, 16 + BOX_SIZE, 2, GT_DARK_GRAY);
+	gt_bg_restore();
+	gt_flip();
+	gt_bg_restore();
+	gt_flip();
+
+	unsigned angle = 0;
+
+	for (;;)
+	{
+		for (byte i = 0; i < NUM_BOXES; i++)
+			ring_angle[i] = (int)(angle + i * (65536L / NUM_BOXES));
+
+		// Main CPU alone
+		gt_prof_begin(ZONE_SINGLE);
+		cordic_sincos_n(ring_angle, single_sin, single_cos, NUM_BOXES);
+		gt_prof_end(ZONE_SINGLE);
+
+		// Both CPUs: post the coprocessor's share first, work through the
+		// rest meanwhile, then collect
+		gt_prof_begin(ZONE_DUAL);
+		byte main_n = NUM_BOXES - acp_share;
+		byte ticket = gt_acp_cordic(GT_ACP_PAGE_FIRST, ring_angle + main_n, acp_share,
+		                            CORDIC_START, CORDIC_ITERS);
+		cordic_sincos_n(ring_angle, dual_sin, dual_cos, main_n);
+		byte acp_first = gt_acp_done(ticket);
+		gt_acp_wait(ticket);
+		gt_acp_cordic_read(GT_ACP_PAGE_FIRST, dual_sin + main_n, dual_cos + main_n, acp_share);
+		gt_prof_end(ZONE_DUAL);
+
+		// Give more to whichever side was idle at the end
+		if (acp_first)
+		{
+			if (acp_share < NUM_BOXES - 1)
+				acp_share++;
+		}
+		else if (acp_share > 1)
+			acp_share--;
+
+		byte same = 1;
+		for (byte i = 0; i < NUM_BOXES; i++)
+		{
+			if (dual_sin[i] != single_sin[i] || dual_cos[i] != single_cos[i])
+				same = 0;
+		}
+
+		gt_dirty_restore();
+
+		for (byte i = 0; i < NUM_BOXES; i++)
+		{
+			int px = CX + ((dual_cos[i] + 128) >> 8);
+			int py = CY + ((dual_sin[i] + 128) >> 8);
+			byte color = (i & 1) ? GT_YELLOW : GT_WHITE;
+			gt_dirty_box((byte)px, (byte)py, BOX_SIZE, BOX_SIZE, color);
+		}
+
+		// The strip is redrawn whole every frame, so the bars need no
+		// dirty rectangles of their own. A blit is at most 127 wide, so
+		// it is cleared in two halves like gt_clear().
+		gt_draw_box(0, 0, GT_SCREEN_W / 2, STRIP_H, GT_BLACK);
+		gt_draw_box(GT_SCREEN_W / 2, 0, GT_SCREEN_W / 2, STRIP_H, GT_BLACK);
+		gt_draw_box(2, BAR_Y, bar_len(gt_prof_cycles(ZONE_SINGLE)), BAR_H, GT_WHITE);
+		gt_draw_box(2, BAR_Y + BAR_H + 2, bar_len(gt_prof_cycles(ZONE_DUAL)), BAR_H, GT_GREEN);
+		gt_draw_box(2, BAR_Y + 2 * (BAR_H + 2), acp_share * 4, BAR_H, GT_YELLOW);
+		gt_draw_box(2 + (GT_PROF_FRAME_CYCLES >> GT_PROF_SHIFT), 0, 1, STRIP_H, GT_DARK_GRAY);
+		if (!same)
+			gt_draw_box(GT_SCREEN_W - 2 - BAR_H, BAR_Y, BAR_H, BAR_H, GT_RED);
+
+		gt_prof_sync();
+
+		angle += 96;
+	}
+
+	return 0;
+}
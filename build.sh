@@ -9,7 +9,7 @@ if [ -z "$1" ]; then
     echo "Usage: $0 <tutorial_name>"
     echo "Available tutorials:"
     for d in */; do
-        [ -d "$d" ] && [ "$d" != "lib/" ] && echo "  ${d%/}"
+        [ -d "$d" ] && [ "$d" != "lib/" ] && [ "$d" != "tools/" ] && echo "  ${d%/}"
     done
     exit 1
 fi
@@ -42,9 +42,24 @@ if [ ! -x "$OSCAR64" ]; then
     exit 1
 fi
 
+# Regenerate the shared lookup tables (lib/gt_tables.h/.c) with the host
+# compiler when their definitions or the generator have changed
+GTTAB_DIR="$SCRIPT_DIR/tools/gttab"
+GTTAB="$GTTAB_DIR/gttab"
+TABLES="$SCRIPT_DIR/lib/gt_tables"
+if [ ! -x "$GTTAB" ] || [ "$GTTAB_DIR/gttab.c" -nt "$GTTAB" ]; then
+    "${CC:-cc}" -O2 -o "$GTTAB" "$GTTAB_DIR/gttab.c" -lm
+fi
+if [ "$TABLES.def" -nt "$TABLES.c" ] || [ "$GTTAB" -nt "$TABLES.c" ]; then
+    "$GTTAB" "$TABLES.def" "$TABLES"
+fi
+
 # Oscar64 include path (for crt.h, <c64/types.h>, <gametank/gametank.h> etc.)
 OSCAR64_INCLUDE="$SCRIPT_DIR/../oscar64/include"
 
+# Extra compiler flags, e.g. OSCAR64_FLAGS="-dGT_BLIT_ASM=0"
+OSCAR64_FLAGS="${OSCAR64_FLAGS:-}"
+
 # Output file in tutorial directory
 BASENAME=$(basename "$SOURCE" .c)
 OUTPUT="$TUTORIAL_DIR/$BASENAME.gtr"
@@ -59,9 +74,18 @@ echo "  Output:  $OUTPUT"
     -O2 \
     -ii="$OSCAR64_INCLUDE" \
     -i="$SCRIPT_DIR/lib" \
+    $OSCAR64_FLAGS \
     "$SOURCE" \
     -o="$OUTPUT"
 
+# Data for banked ROM: a tutorial's rom.bin is written over the start of
+# the cartridge (bank 0 onwards), well clear of the program in the last bank
+DATA="$TUTORIAL_DIR/rom.bin"
+if [ -f "$OUTPUT" ] && [ -f "$DATA" ]; then
+    dd if="$DATA" of="$OUTPUT" conv=notrunc status=none
+    echo "  Data:    $DATA"
+fi
+
 if [ -f "$OUTPUT" ]; then
     SIZE=$(wc -c < "$OUTPUT" | tr -d ' ')
     echo "  Success! $OUTPUT ($SIZE bytes)"
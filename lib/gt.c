@@ -4,20 +4,226 @@
 static byte shadow_banking;
 static byte shadow_dma_flags;
 
+// ---------------------------------------------------------------------------
+// Blit Queue
+// ---------------------------------------------------------------------------
+// Pending blits wait in a ring buffer and are fed to the blitter by
+// irq_handler each time the previous blit completes, so drawing calls return
+// immediately and the CPU keeps running while the blitter works. Entries are
+// kept as parallel byte arrays so the handler can use abs,X addressing.
+// Each entry carries the DMA flags it runs with, so color fills and sprite
+// copies can share the queue.
+
+#define BLITQ_SIZE  16
+#define BLITQ_MASK  (BLITQ_SIZE - 1)
+
+static byte blitq_vx[BLITQ_SIZE];
+static byte blitq_vy[BLITQ_SIZE];
+static byte blitq_gx[BLITQ_SIZE];
+static byte blitq_gy[BLITQ_SIZE];
+static byte blitq_w[BLITQ_SIZE];
+static byte blitq_h[BLITQ_SIZE];
+static byte blitq_color[BLITQ_SIZE];
+static byte blitq_flags[BLITQ_SIZE];
+
+static volatile byte blitq_head;   // Next free slot (main thread)
+static volatile byte blitq_tail;   // Next entry to start (IRQ handler)
+static volatile byte blit_busy;    // Nonzero while the blitter is draining
+
+// DMA flags $4000-$7FFF is mapped with for direct CPU access to the draw
+// page or sprite RAM; 0 while the blitter registers are mapped
+static byte cpu_vram;
+
+// Arguments of gt_draw_box_zp(), and its scratch
+__zeropage byte gt_box_x, gt_box_y, gt_box_w, gt_box_h, gt_box_color;
+static byte box_next;
+static byte box_slow;
+
+// Arguments of gt_blit_tiles() for its assembly loop
+static __zeropage const byte * tile_src;
+static byte tile_x, tile_y, tile_n, tile_w, tile_h;
+static byte tile_skip, tile_gy, tile_sx;
+static byte sheet_gx, sheet_gy;
+
+// Bank currently latched into the cartridge's bank register
+static byte rom_bank;
+
+// ---------------------------------------------------------------------------
+// Frame Counter and Deferred Register Writes
+// ---------------------------------------------------------------------------
+// Writes to banking and dma_flags that have to land inside vblank (page
+// flips, mode changes) wait in a ring buffer as register / value pairs and
+// are applied in order by nmi_handler. Registers are offsets from $2000.
+// The shadows already hold the new values while writes are pending, so
+// anything that writes these registers from the main thread, or relies on
+// the draw page, first waits for the queue to empty with defer_wait().
+
+#define DEFER_SIZE  8
+#define DEFER_MASK  (DEFER_SIZE - 1)
+
+#define DEFER_BANKING    0x05
+#define DEFER_DMA_FLAGS  0x07
+
+static byte defer_reg[DEFER_SIZE];
+static byte defer_val[DEFER_SIZE];
+
+static volatile byte defer_head;   // Next free slot (main thread)
+static volatile byte defer_tail;   // Next write to apply (NMI handler)
+
+// Vblanks since gt_init()
+static volatile unsigned frame_count;
+
+// ---------------------------------------------------------------------------
+// Gamepad Sampling
+// ---------------------------------------------------------------------------
+// nmi_handler reads both pads once per vblank. Bytes are indexed
+// port * 2 + read (low byte first), active-high like gt_read_gamepad().
+// The handler keeps the latest state and ORs in every press and release it
+// sees; gt_sync() and gt_wait_vblank() hand that over to the pad_held /
+// pad_pressed / pad_released copies the main thread reads, so the state is
+// stable for a whole frame and no edge between two frames is lost.
+
+static byte pad_new[4];              // This vblank's reads (NMI scratch)
+static byte pad_edge;                // Changed bits (NMI scratch)
+static volatile byte pad_state[4];   // Latest sample
+static volatile byte pad_down[4];    // Presses since the last hand-over
+static volatile byte pad_up[4];      // Releases since the last hand-over
+static volatile byte pad_lock;       // Nonzero during a hand-over
+
+static unsigned pad_held[2];
+static unsigned pad_pressed[2];
+static unsigned pad_released[2];
+
 // ---------------------------------------------------------------------------
 // Interrupt Handlers
 // ---------------------------------------------------------------------------
 
-// NMI is triggered by GameTank vblank
+// NMI is triggered by GameTank vblank; DMA_NMI stays enabled so it runs
+// every frame. Apply the deferred register writes first, while the blank
+// has just started, then count the frame and sample both gamepads.
 __asm nmi_handler
 {
+	pha
+	txa
+	pha
+	tya
+	pha
+
+	ldx defer_tail
+apply:
+	cpx defer_head
+	beq applied
+	ldy defer_reg, x
+	lda defer_val, x
+	sta 0x2000, y
+	inx
+	txa
+	and #DEFER_MASK
+	tax
+	jmp apply
+applied:
+	stx defer_tail
+
+	inc frame_count
+	bne counted
+	inc frame_count + 1
+counted:
+
+	// The main thread is taking the pad state; skip this sample, the
+	// next one sees the same changes
+	lda pad_lock
+	bne pads_done
+
+	// Reading one port resets the other's select line, so each pair of
+	// reads returns the low byte, then the high byte
+	lda 0x2009             // Reset pad 1
+	lda 0x2008
+	sta pad_new
+	lda 0x2008
+	sta pad_new + 1
+	lda 0x2009
+	sta pad_new + 2
+	lda 0x2009
+	sta pad_new + 3
+
+	ldx #3
+bytes:
+	lda pad_new, x
+	eor #0xff              // Buttons are active-low
+	sta pad_new, x
+	eor pad_state, x
+	sta pad_edge
+	and pad_new, x
+	ora pad_down, x
+	sta pad_down, x
+	lda pad_edge
+	and pad_state, x
+	ora pad_up, x
+	sta pad_up, x
+	lda pad_new, x
+	sta pad_state, x
+	dex
+	bpl bytes
+
+pads_done:
+	pla
+	tay
+	pla
+	tax
+	pla
 	rti
 }
 
-// IRQ is triggered when blitter finishes a DMA operation
+// IRQ is triggered when blitter finishes a DMA operation.
+// Acknowledge it, then start the next queued fill, or go idle and drop
+// color fill mode when the queue is empty.
 __asm irq_handler
 {
+	pha
+	txa
+	pha
+
 	byt 0x9c, 0x06, 0x40   // stz $4006 — clear blitter IRQ
+
+	ldx blitq_tail
+	cpx blitq_head
+	beq idle
+
+	lda blitq_flags, x
+	sta 0x2007             // Fill or copy mode for this entry
+	lda blitq_vx, x
+	sta 0x4000
+	lda blitq_vy, x
+	sta 0x4001
+	lda blitq_gx, x
+	sta 0x4002
+	lda blitq_gy, x
+	sta 0x4003
+	lda blitq_w, x
+	sta 0x4004
+	lda blitq_h, x
+	sta 0x4005
+	lda blitq_color, x
+	sta 0x4007
+	lda #1
+	sta 0x4006             // Trigger DMA
+
+	inx
+	txa
+	and #BLITQ_MASK
+	sta blitq_tail
+	jmp done
+
+idle:
+	lda #0
+	sta blit_busy
+	lda shadow_dma_flags
+	sta 0x2007             // Restore DMA flags
+
+done:
+	pla
+	tax
+	pla
 	rti
 }
 
@@ -47,17 +253,21 @@ __export struct Vectors
 // ---------------------------------------------------------------------------
 // ROM Bank Selection via VIA SPI
 // ---------------------------------------------------------------------------
+// The bank register on the cartridge is a shift register, so every switch
+// shifts all eight bits. Shifting the bank left one place per bit keeps the
+// loop free of variable shifts, which the 6502 can only do with a loop.
+// Port A's direction is set once by gt_init().
 static void via_set_rom_bank(byte bank)
 {
-	gtvia.ddra = 0x07;     // Set low 3 bits of port A as outputs
 	gtvia.iora = 0;
 
 	// Bit-bang 8-bit bank number MSB first
-	for (signed char i = 7; i >= 0; i--)
+	for (byte i = 0; i < 8; i++)
 	{
-		byte data_bit = (bank >> i) & 1 ? VIA_SPI_MOSI : 0;
+		byte data_bit = (bank & 0x80) ? VIA_SPI_MOSI : 0;
 		gtvia.iora = data_bit;
 		gtvia.iora = data_bit | VIA_SPI_CLK;   // Clock rising edge
+		bank <<= 1;
 	}
 
 	gtvia.iora = VIA_SPI_CS;   // Latch
@@ -75,6 +285,157 @@ static void wait_for_irq(void)
 	}
 }
 
+// Start the fill at the tail of the queue. Called with interrupts masked.
+static void blitq_start(void)
+{
+	byte i = blitq_tail;
+
+	gtsys.dma_flags = blitq_flags[i];
+	gtblitter.vx = blitq_vx[i];
+	gtblitter.vy = blitq_vy[i];
+	gtblitter.gx = blitq_gx[i];
+	gtblitter.gy = blitq_gy[i];
+	gtblitter.width = blitq_w[i];
+	gtblitter.height = blitq_h[i];
+	gtblitter.color = blitq_color[i];
+	gtblitter.start = 1;       // Trigger DMA
+
+	blitq_tail = (i + 1) & BLITQ_MASK;
+}
+
+// Wait until nmi_handler has applied every deferred write. This spins
+// rather than sleeping in WAI: NMI cannot be masked, so one arriving
+// between the test and the WAI would leave the CPU asleep for a whole
+// frame.
+static void defer_wait(void)
+{
+	while (defer_head != defer_tail)
+		;
+}
+
+// Queue a write for the next vblank, waiting while the queue is full
+static void defer_push(byte reg, byte value)
+{
+	byte i = defer_head;
+	byte next = (i + 1) & DEFER_MASK;
+	while (next == defer_tail)
+		;
+
+	defer_reg[i] = reg;
+	defer_val[i] = value;
+	defer_head = next;
+}
+
+// ---------------------------------------------------------------------------
+// Direct VRAM Access
+// ---------------------------------------------------------------------------
+// With DMA_ENABLE clear, $4000-$7FFF is a window onto VRAM instead of the
+// blitter registers, and DMA_CPU_TO_VRAM selects the framebuffer (the page
+// chosen by BANK_VRAM_SELECT) rather than sprite RAM. The window stays
+// mapped across gt_plot() calls and is unmapped lazily by the next call
+// that needs the blitter or touches the DMA flags.
+
+static void cpu_vram_map(byte flags)
+{
+	if (cpu_vram != flags)
+	{
+		// irq_handler writes the blitter registers, so the queue has
+		// to be empty before they disappear from the address space, and
+		// a pending flip would map them back in
+		gt_blit_flush();
+		defer_wait();
+		gtsys.dma_flags = flags;
+		cpu_vram = flags;
+	}
+}
+
+static void cpu_vram_begin(void)
+{
+	cpu_vram_map((shadow_dma_flags & ~DMA_ENABLE) | DMA_CPU_TO_VRAM);
+}
+
+static void cpu_vram_end(void)
+{
+	if (cpu_vram)
+	{
+		gtsys.dma_flags = shadow_dma_flags;
+		cpu_vram = 0;
+	}
+}
+
+// Map the 128x128 quadrant of sprite RAM that contains (gx, gy). The
+// quadrant is chosen by bit 7 of the last gx / gy register writes, which
+// needs the blitter registers mapped.
+static void cpu_gram_begin(byte gx, byte gy)
+{
+	cpu_vram_end();
+	gt_blit_flush();
+	gtblitter.gx = gx;
+	gtblitter.gy = gy;
+	cpu_vram_map(shadow_dma_flags & ~(DMA_ENABLE | DMA_CPU_TO_VRAM));
+}
+
+// Append a blit to the queue, kicking the blitter if it is idle
+static void blitq_push(byte x, byte y, byte gx, byte gy, byte w, byte h, byte color, byte flags)
+{
+	cpu_vram_end();
+
+	// After gt_sync() the next frame's blits are for the page still on
+	// screen, so they wait until the flip has happened
+	defer_wait();
+
+	// Queue full: sleep until irq_handler has started the next entry
+	byte i = blitq_head;
+	byte next = (i + 1) & BLITQ_MASK;
+	while (next == blitq_tail)
+		wait_for_irq();
+
+	blitq_vx[i] = x;
+	blitq_vy[i] = y;
+	blitq_gx[i] = gx;
+	blitq_gy[i] = gy;
+	blitq_w[i] = w;
+	blitq_h[i] = h;
+	blitq_color[i] = color;
+	blitq_flags[i] = flags;
+
+	__asm volatile { sei }
+
+	blitq_head = next;
+	if (!blit_busy)
+	{
+		// irq_handler restores the DMA flags once the queue drains
+		blit_busy = 1;
+		blitq_start();
+	}
+
+	__asm volatile { cli }
+}
+
+static void blitq_fill(byte x, byte y, byte w, byte h, byte color)
+{
+	blitq_push(x, y, 0, 0, w, h, color, shadow_dma_flags | DMA_COLORFILL);
+}
+
+// Take over the pad state nmi_handler gathered since the last frame. NMI
+// cannot be masked, so pad_lock keeps the handler away meanwhile.
+static void pad_latch(void)
+{
+	pad_lock = 1;
+
+	for (byte port = 0; port < 2; port++)
+	{
+		byte i = port * 2;
+		pad_held[port] = (unsigned)pad_state[i + 1] << 8 | pad_state[i];
+		pad_pressed[port] = (unsigned)pad_down[i + 1] << 8 | pad_down[i];
+		pad_released[port] = (unsigned)pad_up[i + 1] << 8 | pad_up[i];
+		pad_down[i] = pad_down[i + 1] = 0;
+		pad_up[i] = pad_up[i + 1] = 0;
+	}
+
+	pad_lock = 0;
+}
+
 // ---------------------------------------------------------------------------
 // Library Functions
 // ---------------------------------------------------------------------------
@@ -87,7 +448,9 @@ void gt_init(void)
 	gtsys.banking = shadow_banking;
 
 	// Select ROM bank 254 (banked region, required for 2MB carts)
-	via_set_rom_bank(254);
+	gtvia.ddra = 0x07;     // Set low 3 bits of port A as outputs
+	rom_bank = GT_ROM_BANK_DEFAULT;
+	via_set_rom_bank(rom_bank);
 
 	// Clear audio subsystem
 	gtsys.audio_reset = 0;
@@ -97,12 +460,17 @@ void gt_init(void)
 	// Clear any pending blitter IRQ
 	gtblitter.start = 0;
 
-	// Set default DMA flags: enable DMA, enable IRQ, opaque mode.
+	// The startup code leaves interrupts masked; irq_handler has to run
+	// to drain the blit queue.
+	__asm volatile { cli }
+
+	// Set default DMA flags: enable DMA, enable IRQ, vblank NMI (which
+	// samples the gamepads), opaque mode.
 	// DMA_PAGE_OUT is set here so that after the first gt_flip(),
 	// the display page (0) and draw page (1) are different.
 	// Without this, both pages start in sync and we'd draw on the
 	// visible buffer, causing flickering.
-	shadow_dma_flags = DMA_ENABLE | DMA_PAGE_OUT | DMA_IRQ | DMA_OPAQUE;
+	shadow_dma_flags = DMA_ENABLE | DMA_PAGE_OUT | DMA_NMI | DMA_IRQ | DMA_OPAQUE;
 	gtsys.dma_flags = shadow_dma_flags;
 
 	// Flip once: display toggles to page 0, blitter toggles to page 1
@@ -118,6 +486,12 @@ void gt_init(void)
 
 void gt_flip(void)
 {
+	// Queued fills belong to the current draw page, and a flip requested
+	// by gt_sync() has to happen first
+	cpu_vram_end();
+	gt_blit_flush();
+	defer_wait();
+
 	// Toggle which framebuffer page is shown on screen
 	shadow_dma_flags ^= DMA_PAGE_OUT;
 	gtsys.dma_flags = shadow_dma_flags;
@@ -127,107 +501,589 @@ void gt_flip(void)
 	gtsys.banking = shadow_banking;
 }
 
+byte gt_draw_page(void)
+{
+	return (shadow_banking & BANK_VRAM_SELECT) ? 1 : 0;
+}
+
+#if GT_BLIT_ASM
+
 void gt_clear(byte color)
 {
 	// The blitter's width/height fields are 7 bits (bit 7 = flip flag),
 	// so a single operation covers at most 127x127 pixels. The framebuffer
-	// is 128x128, so we tile it with four 64x64 quadrants.
-	gtsys.dma_flags = shadow_dma_flags | DMA_COLORFILL;
+	// is 128x128, so we tile it with four 64x64 quadrants; only the
+	// position changes between them.
+	gt_box_w = 64;
+	gt_box_h = 64;
+	gt_box_color = color;
 
-	gtblitter.width = 64;
-	gtblitter.height = 64;
-	gtblitter.color = color;
+	gt_box_x = 0;  gt_box_y = 0;  gt_draw_box_zp();
+	gt_box_x = 64;                gt_draw_box_zp();
+	gt_box_x = 0;  gt_box_y = 64; gt_draw_box_zp();
+	gt_box_x = 64;                gt_draw_box_zp();
+}
 
-	gtblitter.vx = 0;
-	gtblitter.vy = 0;
-	gtblitter.start = 1;
-	wait_for_irq();
+void gt_draw_box(byte x, byte y, byte w, byte h, byte color)
+{
+	gt_box_x = x;
+	gt_box_y = y;
+	gt_box_w = w;
+	gt_box_h = h;
+	gt_box_color = color;
+	gt_draw_box_zp();
+}
 
-	gtblitter.vx = 64;
-	gtblitter.vy = 0;
-	gtblitter.start = 1;
-	wait_for_irq();
+void gt_draw_box_zp(void)
+{
+	// Common case in assembly: blitter registers mapped, no flip pending.
+	// With the blitter idle the fill starts straight from the arguments
+	// without going through the queue (about 105 cycles including the
+	// call); otherwise it is appended (about 130). The C path below costs
+	// about 370 and 270: five arguments copied into each of gt_draw_box(),
+	// blitq_fill() and blitq_push(), calls to cpu_vram_end() and
+	// defer_wait(), eight queue stores, and blitq_start() reading them all
+	// back even when the blitter is idle. Interrupts stay masked
+	// from the busy test to the head update, so irq_handler cannot go idle
+	// in between and strand the entry. gx / gy are left alone, fills do
+	// not read them.
+	__asm volatile
+	{
+		lda cpu_vram
+		bne slow
+		lda defer_head
+		cmp defer_tail
+		bne slow
 
-	gtblitter.vx = 0;
-	gtblitter.vy = 64;
-	gtblitter.start = 1;
-	wait_for_irq();
+		sei
+		lda blit_busy
+		beq start
 
-	gtblitter.vx = 64;
-	gtblitter.vy = 64;
-	gtblitter.start = 1;
-	wait_for_irq();
+		ldx blitq_head
+		inx
+		txa
+		and #BLITQ_MASK
+		cmp blitq_tail
+		beq full
+		sta box_next
+		dex
 
-	gtsys.dma_flags = shadow_dma_flags;
+		lda gt_box_x
+		sta blitq_vx, x
+		lda gt_box_y
+		sta blitq_vy, x
+		lda gt_box_w
+		sta blitq_w, x
+		lda gt_box_h
+		sta blitq_h, x
+		lda gt_box_color
+		sta blitq_color, x
+		lda shadow_dma_flags
+		ora #DMA_COLORFILL
+		sta blitq_flags, x
+
+		lda box_next
+		sta blitq_head
+		jmp done
+
+	full:
+	slow:
+		lda #1
+		sta box_slow
+		jmp done
+
+	start:
+		lda #1
+		sta blit_busy
+		lda shadow_dma_flags
+		ora #DMA_COLORFILL
+		sta 0x2007
+		lda gt_box_x
+		sta 0x4000
+		lda gt_box_y
+		sta 0x4001
+		lda gt_box_w
+		sta 0x4004
+		lda gt_box_h
+		sta 0x4005
+		lda gt_box_color
+		sta 0x4007
+		lda #1
+		sta 0x4006             // Trigger DMA
+
+	done:
+		cli
+	}
+
+	// Everything else takes the C path, which can wait
+	if (box_slow)
+	{
+		box_slow = 0;
+		blitq_fill(gt_box_x, gt_box_y, gt_box_w, gt_box_h, gt_box_color);
+	}
+}
+
+#else
+
+void gt_clear(byte color)
+{
+	blitq_fill(0, 0, 64, 64, color);
+	blitq_fill(64, 0, 64, 64, color);
+	blitq_fill(0, 64, 64, 64, color);
+	blitq_fill(64, 64, 64, 64, color);
 }
 
 void gt_draw_box(byte x, byte y, byte w, byte h, byte color)
 {
-	// Enable color fill mode
-	gtsys.dma_flags = shadow_dma_flags | DMA_COLORFILL;
+	blitq_fill(x, y, w, h, color);
+}
 
-	gtblitter.vx = x;
-	gtblitter.vy = y;
-	gtblitter.width = w;
-	gtblitter.height = h;
-	gtblitter.color = color;
-	gtblitter.start = 1;       // Trigger DMA
+void gt_draw_box_zp(void)
+{
+	blitq_fill(gt_box_x, gt_box_y, gt_box_w, gt_box_h, gt_box_color);
+}
 
-	wait_for_irq();            // Wait for blitter to finish
+#endif
 
-	// Restore DMA flags
-	gtsys.dma_flags = shadow_dma_flags;
+void gt_blit_sprite(byte x, byte y, byte gx, byte gy, byte w, byte h, byte flags)
+{
+	// GCARRY lets the source run across 16-pixel tile boundaries; without
+	// OPAQUE, source pixels of value 0 are skipped
+	byte dma = (shadow_dma_flags & ~DMA_OPAQUE) | DMA_GCARRY;
+	if (flags & GT_SPRITE_OPAQUE)
+		dma |= DMA_OPAQUE;
+	if (flags & GT_SPRITE_FLIP_H)
+		w |= 0x80;
+	if (flags & GT_SPRITE_FLIP_V)
+		h |= 0x80;
+
+	blitq_push(x, y, gx, gy, w, h, 0, dma);
 }
 
-void gt_wait_vblank(void)
+void gt_tile_sheet(byte gx, byte gy)
 {
-	// Enable NMI (fires on vertical blank)
-	shadow_dma_flags |= DMA_NMI;
-	gtsys.dma_flags = shadow_dma_flags;
+	sheet_gx = gx;
+	sheet_gy = gy;
+}
+
+void gt_blit_tiles(byte x, byte y, const byte * tiles, byte n, byte skip_x, byte skip_y)
+{
+	if (!n)
+		return;
+
+	// The loop below drives the blitter itself, so nothing may be queued
+	// and the flip from gt_sync() has to be done
+	cpu_vram_end();
+	gt_blit_flush();
+	defer_wait();
+
+	tile_src = tiles;
+	tile_x = x;
+	tile_y = y;
+	tile_n = n;
+	tile_skip = skip_x;
+	tile_w = 8 - skip_x;
+	tile_h = 8 - skip_y;
+	tile_gy = sheet_gy + skip_y;
 
-	// Halt CPU until NMI fires
+	// With interrupts masked, WAI still wakes when the blit completes and
+	// the IRQ stays pending until it is cleared here. It also wakes for the
+	// vblank NMI, which is told apart by the frame counter moving. Height,
+	// y and DMA flags are the same for the whole row; the width changes
+	// once, after the first tile. The last tile is left running with
+	// blit_busy set, for irq_handler to retire.
 	__asm volatile
 	{
-		byt 0xcb    // WAI
+		sei
+		lda shadow_dma_flags
+		ora #DMA_OPAQUE
+		sta 0x2007
+		lda tile_y
+		sta 0x4001
+		lda tile_h
+		sta 0x4005
+		lda tile_w
+		sta 0x4004
+
+		ldy #0
+		lda (tile_src), y
+		tax
+		and #0x0f
+		asl
+		asl
+		asl
+		ora sheet_gx
+		ora tile_skip
+		sta 0x4002
+		txa
+		and #0xf0
+		lsr
+		clc
+		adc tile_gy
+		sta 0x4003
+		lda tile_x
+		sta 0x4000
+		clc
+		adc tile_w
+		sta tile_x
+		lda #1
+		sta 0x4006             // Trigger DMA
+		iny
+		cpy tile_n
+		beq done
+
+	next:
+		lda (tile_src), y
+		tax
+		and #0x0f
+		asl
+		asl
+		asl
+		ora sheet_gx
+		sta tile_sx
+		txa
+		and #0xf0
+		lsr
+		clc
+		adc tile_gy
+		tax
+
+	wait:
+		lda frame_count
+		byt 0xcb               // WAI
+		cmp frame_count
+		bne wait
+		byt 0x9c, 0x06, 0x40   // stz $4006 — clear blitter IRQ
+
+		cpy #1
+		bne same
+		lda #8
+		sta 0x4004
+	same:
+		stx 0x4003
+		lda tile_sx
+		sta 0x4002
+		lda tile_x
+		sta 0x4000
+		clc
+		adc #8
+		sta tile_x
+		lda #1
+		sta 0x4006             // Trigger DMA
+		iny
+		cpy tile_n
+		bne next
+
+	done:
+		lda #1
+		sta blit_busy
+		cli
 	}
+}
 
-	// Disable NMI until next frame
-	shadow_dma_flags &= ~DMA_NMI;
-	gtsys.dma_flags = shadow_dma_flags;
+void gt_sprite_upload(byte gx, byte gy, byte w, byte h, const byte * src)
+{
+	cpu_gram_begin(gx, gy);
+
+	for (byte j = 0; j < h; j++)
+	{
+		byte * row = (byte *)gtvram + (((unsigned)((gy + j) & 0x7f) << 7) | (gx & 0x7f));
+		for (byte i = 0; i < w; i++)
+			row[i] = src[i];
+		src += w;
+	}
+
+	cpu_vram_end();
 }
 
-void gt_sync(void)
+void gt_sprite_fill(byte gx, byte gy, byte w, byte h, byte value)
 {
-	// Enable NMI temporarily (don't modify shadow — it doesn't have NMI)
-	gtsys.dma_flags = shadow_dma_flags | DMA_NMI;
+	cpu_gram_begin(gx, gy);
+
+	for (byte j = 0; j < h; j++)
+	{
+		byte * row = (byte *)gtvram + (((unsigned)((gy + j) & 0x7f) << 7) | (gx & 0x7f));
+		for (byte i = 0; i < w; i++)
+			row[i] = value;
+	}
+
+	cpu_vram_end();
+}
+
+static unsigned asset_read(struct GTAsset * a, byte * dst, unsigned n);
+
+void gt_sprite_map(byte gx, byte gy)
+{
+	cpu_gram_begin(gx, gy);
+}
 
-	// Halt CPU until vblank NMI fires
+unsigned gt_sprite_upload_asset(struct GTAsset * a, byte gx, byte gy, byte w, byte h)
+{
+	cpu_gram_begin(gx, gy);
+
+	unsigned done = 0;
+	for (byte j = 0; j < h; j++)
+	{
+		byte * row = (byte *)gtvram + (((unsigned)((gy + j) & 0x7f) << 7) | (gx & 0x7f));
+		unsigned n = asset_read(a, row, w);
+		done += n;
+		if (n < w)
+			break;
+	}
+
+	cpu_vram_end();
+	gt_rom_bank(GT_ROM_BANK_DEFAULT);
+	return done;
+}
+
+void gt_plot(byte x, byte y, byte color)
+{
+	if ((x | y) & 0x80)
+		return;
+
+	cpu_vram_begin();
+
+	// The blitter writes the inverted color register, so invert here too
+	// to make GT_* colors look the same either way
+	gtvram[((unsigned)y << 7) | x] = ~color;
+}
+
+void gt_plot_span(byte x, byte y, byte w, byte color)
+{
+	if ((x | y) & 0x80)
+		return;
+	if (w > GT_SCREEN_W - x)
+		w = GT_SCREEN_W - x;
+
+	cpu_vram_begin();
+
+	volatile byte * p = gtvram + (((unsigned)y << 7) | x);
+	byte v = ~color;
+	for (byte i = 0; i < w; i++)
+		p[i] = v;
+}
+
+void gt_blit_flush(void)
+{
+	// Sleep until irq_handler has drained the queue. Interrupts are masked
+	// while testing blit_busy so the final IRQ cannot slip in between the
+	// test and the WAI. WAI still wakes on a masked IRQ, and the short
+	// unmasked window after it lets irq_handler run.
 	__asm volatile
 	{
+		sei
+	wait:
+		lda blit_busy
+		beq done
 		byt 0xcb    // WAI
+		cli
+		nop
+		sei
+		jmp wait
+	done:
+		cli
 	}
+}
+
+void gt_wait_vblank(void)
+{
+	cpu_vram_end();
+	gt_blit_flush();
+
+	// Spin until nmi_handler has counted another frame (see defer_wait())
+	byte frame = (byte)frame_count;
+	while ((byte)frame_count == frame)
+		;
 
-	// NMI just returned — we are inside the vblank window.
-	// Flip the display page immediately. Writing shadow_dma_flags
-	// (which has no DMA_NMI) also disables NMI in the same write.
+	pad_latch();
+}
+
+void gt_sync(void)
+{
+	// The draw page must be complete before it is shown
+	cpu_vram_end();
+	gt_blit_flush();
+
+	// Only one flip per vblank; two would cancel out
+	defer_wait();
+
+	// nmi_handler performs the flip at the start of the next vblank.
+	// Drawing for the next frame waits for it, everything else can start
+	// right away.
 	shadow_dma_flags ^= DMA_PAGE_OUT;
-	gtsys.dma_flags = shadow_dma_flags;
+	defer_push(DEFER_DMA_FLAGS, shadow_dma_flags);
 
 	shadow_banking ^= BANK_VRAM_SELECT;
-	gtsys.banking = shadow_banking;
+	defer_push(DEFER_BANKING, shadow_banking);
+
+	pad_latch();
+}
+
+void gt_defer_banking(byte mask, byte value)
+{
+	cpu_vram_end();
+	gt_blit_flush();
+
+	shadow_banking = (shadow_banking & ~mask) | (value & mask);
+	defer_push(DEFER_BANKING, shadow_banking);
+}
+
+void gt_defer_dma_flags(byte mask, byte value)
+{
+	// Running blits would switch to the new mode when their flags are
+	// restored, so finish them first
+	cpu_vram_end();
+	gt_blit_flush();
+
+	shadow_dma_flags = (shadow_dma_flags & ~mask) | (value & mask);
+	defer_push(DEFER_DMA_FLAGS, shadow_dma_flags);
+}
+
+void gt_defer_wait(void)
+{
+	defer_wait();
+}
+
+unsigned gt_frame_count(void)
+{
+	// nmi_handler may count between the two byte reads; read until two
+	// reads agree
+	unsigned frame;
+	do
+	{
+		frame = frame_count;
+	} while (frame != frame_count);
+
+	return frame;
+}
+
+// ---------------------------------------------------------------------------
+// Banked ROM Assets
+// ---------------------------------------------------------------------------
+
+void gt_rom_bank(byte bank)
+{
+	if (bank != rom_bank)
+	{
+		rom_bank = bank;
+		via_set_rom_bank(bank);
+	}
+}
+
+void gt_asset_open(struct GTAsset * a, byte bank, unsigned offset, unsigned size)
+{
+	a->bank = bank + (byte)(offset >> 14);
+	a->addr = GT_ROM_WINDOW + (offset & (GT_ROM_BANK_SIZE - 1));
+	a->left = size;
+	a->head = 0;
+	a->fill = 0;
+}
+
+// Copy n bytes (at most a->left) straight from ROM, crossing into the next
+// bank at the end of the window. Only one switch per bank touched.
+static void asset_fetch(struct GTAsset * a, byte * dst, unsigned n)
+{
+	a->left -= n;
+	while (n)
+	{
+		unsigned chunk = GT_ROM_WINDOW + GT_ROM_BANK_SIZE - a->addr;
+		if (chunk > n)
+			chunk = n;
+
+		gt_rom_bank(a->bank);
+		const byte * src = (const byte *)a->addr;
+		for (unsigned i = 0; i < chunk; i++)
+			dst[i] = src[i];
+
+		dst += chunk;
+		n -= chunk;
+		a->addr += chunk;
+		if (a->addr == GT_ROM_WINDOW + GT_ROM_BANK_SIZE)
+		{
+			a->addr = GT_ROM_WINDOW;
+			a->bank++;
+		}
+	}
+}
+
+// gt_asset_read() without restoring the default bank, so that a loop of
+// reads switches banks only where the data does
+static unsigned asset_read(struct GTAsset * a, byte * dst, unsigned n)
+{
+	unsigned done = 0;
+	for (;;)
+	{
+		// Serve buffered bytes first
+		while (done < n && a->head < a->fill)
+			dst[done++] = a->buf[a->head++];
+
+		unsigned want = n - done;
+		if (!want || !a->left)
+			return done;
+
+		if (want >= GT_ASSET_PREFETCH)
+		{
+			// Large reads skip the buffer
+			if (want > a->left)
+				want = a->left;
+			asset_fetch(a, dst + done, want);
+			return done + want;
+		}
+
+		// Small reads refill the buffer with the bytes that follow, so a
+		// run of small sequential reads switches banks once per buffer
+		byte fill = GT_ASSET_PREFETCH;
+		if (fill > a->left)
+			fill = (byte)a->left;
+		asset_fetch(a, a->buf, fill);
+		a->head = 0;
+		a->fill = fill;
+	}
+}
+
+unsigned gt_asset_read(struct GTAsset * a, byte * dst, unsigned n)
+{
+	unsigned done = asset_read(a, dst, n);
+	gt_rom_bank(GT_ROM_BANK_DEFAULT);
+	return done;
+}
+
+unsigned gt_asset_read_vram(struct GTAsset * a, byte x, byte y, byte w, byte h)
+{
+	cpu_vram_begin();
+
+	unsigned done = 0;
+	for (byte j = 0; j < h; j++)
+	{
+		byte * row = (byte *)gtvram + (((unsigned)(byte)(y + j) << 7) | x);
+		unsigned n = asset_read(a, row, w);
+		done += n;
+		if (n < w)
+			break;
+	}
+
+	gt_rom_bank(GT_ROM_BANK_DEFAULT);
+	return done;
 }
 
 unsigned gt_read_gamepad(void)
 {
-	// Read gamepad2 to reset the input latch
-	volatile byte unused = gtsys.gamepad2;
-	(void)unused;
+	// The pads belong to nmi_handler; reading them here would break its
+	// read sequence
+	return pad_held[0];
+}
 
-	// Two consecutive reads of gamepad1: low byte, then high byte
-	byte lo = gtsys.gamepad1;
-	__asm volatile {}          // Compiler barrier between reads
-	byte hi = gtsys.gamepad1;
+unsigned gt_pad_held(byte port)
+{
+	return pad_held[port];
+}
 
-	// Combine into 16-bit value and invert (buttons are active-low)
-	return ~((unsigned)hi << 8 | lo);
+unsigned gt_pad_pressed(byte port)
+{
+	return pad_pressed[port];
+}
+
+unsigned gt_pad_released(byte port)
+{
+	return pad_released[port];
 }
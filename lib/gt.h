@@ -64,6 +64,14 @@ struct GTVIA
 
 #define gtvia (*((struct GTVIA *)0x2800))
 
+// Framebuffer window at $4000 (128 bytes per row) while mapped for CPU
+// writes by gt_plot() / gt_plot_span()
+#define gtvram ((volatile byte *)0x4000)
+
+// Audio coprocessor RAM at $3000-$3FFF, which the coprocessor itself sees
+// at $0000-$0FFF
+#define gtaram ((volatile byte *)0x3000)
+
 // ---------------------------------------------------------------------------
 // Banking Register Bits ($2005)
 // ---------------------------------------------------------------------------
@@ -108,6 +116,34 @@ struct GTVIA
 #define GT_SCREEN_W   128
 #define GT_SCREEN_H   128
 
+// ---------------------------------------------------------------------------
+// Banked ROM
+// ---------------------------------------------------------------------------
+// A 2MB cartridge holds 16KB banks. The program lives in the last bank,
+// which is always mapped at $C000-$FFFF; any bank can be mapped into the
+// window at $8000-$BFFF. Bank numbers are the value shifted into the
+// cartridge's bank register; gt_init() selects GT_ROM_BANK_DEFAULT, the
+// bank the program may have code or constants linked into. Library calls
+// that map another bank map the default back before they return, and
+// code calling gt_rom_bank() itself must do the same before touching
+// anything that could live in the window.
+#define GT_ROM_WINDOW        0x8000
+#define GT_ROM_BANK_SIZE     0x4000
+#define GT_ROM_BANK_DEFAULT  254
+
+// Bytes an asset reads ahead for small sequential reads
+#define GT_ASSET_PREFETCH    32
+
+// Read position in a block of data stored in banked ROM
+struct GTAsset
+{
+	byte     bank;                     // Bank of the next byte to fetch
+	unsigned addr;                     // Its address in the ROM window
+	unsigned left;                     // Bytes not yet fetched
+	byte     head, fill;               // Unread bytes are buf[head..fill)
+	byte     buf[GT_ASSET_PREFETCH];
+};
+
 // ---------------------------------------------------------------------------
 // Color Helpers
 // ---------------------------------------------------------------------------
@@ -139,21 +175,151 @@ void gt_init(void);
 // Flip the double-buffered framebuffer (swap display and draw pages)
 void gt_flip(void);
 
+// Index (0 or 1) of the framebuffer page currently being drawn into
+byte gt_draw_page(void);
+
 // Clear the entire screen with a solid color
 void gt_clear(byte color);
 
-// Draw a filled rectangle at (x,y) with dimensions w x h
+// Draw a filled rectangle at (x,y) with dimensions w x h.
+// Fills are queued and drawn by the blitter in the background; the call
+// only blocks when the queue is full.
 void gt_draw_box(byte x, byte y, byte w, byte h, byte color);
 
+// gt_clear() and gt_draw_box() go through an assembly fast path that takes
+// its arguments in zero page. Build with -dGT_BLIT_ASM=0 to use the plain C
+// queue instead, e.g. to compare the two with gt_prof.h.
+#ifndef GT_BLIT_ASM
+#define GT_BLIT_ASM 1
+#endif
+
+// Zero-page arguments of gt_draw_box_zp(). They keep their values between
+// calls, so a loop drawing boxes of one size or color only stores what
+// changes. Other drawing calls may overwrite them.
+extern __zeropage byte gt_box_x, gt_box_y, gt_box_w, gt_box_h, gt_box_color;
+
+// Same as gt_draw_box() with the arguments above
+void gt_draw_box_zp(void);
+
+// Sprite flags for gt_blit_sprite()
+#define GT_SPRITE_FLIP_H   0x01    // Mirror left to right
+#define GT_SPRITE_FLIP_V   0x02    // Mirror top to bottom
+#define GT_SPRITE_OPAQUE   0x04    // Also draw pixels of value 0
+
+// Copy a w x h sprite from sprite RAM at (gx, gy) to (x, y) in the draw
+// page. Source pixels of value 0 are transparent unless GT_SPRITE_OPAQUE
+// is given; the flip flags mirror the whole sprite in place. Queued like
+// gt_draw_box(), and limited to 127x127 like every blit.
+void gt_blit_sprite(byte x, byte y, byte gx, byte gy, byte w, byte h, byte flags);
+
+// Tile sheets hold 8x8 tiles sixteen to a row: tile t is at
+// (gx + (t & 15) * 8, gy + (t >> 4) * 8) in sprite RAM, with gx 0 or 128.
+// Select the sheet gt_blit_tiles() copies from.
+void gt_tile_sheet(byte gx, byte gy);
+
+// Draw n tiles side by side from (x, y), opaque, with tiles[i] naming the
+// i-th. Made for rows of a tile map: the row keeps the blitter to itself,
+// without the queue, and each tile only rewrites the source and x
+// registers (about 95 cycles, close to the blitter's time for 64 pixels).
+// The first tile loses its left skip_x columns and every tile its top
+// skip_y lines, so a view can start mid-tile; tiles running past the right
+// or bottom edge are clipped by the hardware (BANK_CLIP_X / BANK_CLIP_Y).
+void gt_blit_tiles(byte x, byte y, const byte * tiles, byte n, byte skip_x, byte skip_y);
+
+// Write w x h pixels, row by row, into sprite RAM at (gx, gy). Pixels are
+// VRAM values (palette indices, not inverted like GT_* colors, 0 for
+// transparent). The rectangle must not cross a 128-pixel boundary of the
+// 256x256 sprite RAM. Waits for pending blits first, so upload sprites up
+// front rather than between draws.
+void gt_sprite_upload(byte gx, byte gy, byte w, byte h, const byte * src);
+
+// Set a w x h rectangle of sprite RAM at (gx, gy) to one VRAM value, with
+// the same placement rules as gt_sprite_upload()
+void gt_sprite_fill(byte gx, byte gy, byte w, byte h, byte value);
+
+// Map the 128x128 quadrant of sprite RAM that contains (gx, gy) into the
+// CPU window, for writing many scattered pixels at the cost of one call:
+// sprite RAM pixel (gx, gy) is then gtvram[(gy & 127) << 7 | (gx & 127)].
+// Waits for pending blits first; like gt_plot(), the mapping lasts until
+// the next blitter call.
+void gt_sprite_map(byte gx, byte gy);
+
+// Same as gt_sprite_upload(), but streams the pixels from banked ROM;
+// returns the bytes copied
+unsigned gt_sprite_upload_asset(struct GTAsset * a, byte gx, byte gy, byte w, byte h);
+
+// Plot a single pixel, or a horizontal span of w pixels, by writing the
+// draw page directly from the CPU. The first plot after blitter drawing
+// waits for the blit queue to drain and maps the framebuffer into CPU
+// space; the next blitter call or page flip restores the DMA flags.
+// Consecutive plots are much cheaper than 1-pixel blits.
+void gt_plot(byte x, byte y, byte color);
+void gt_plot_span(byte x, byte y, byte w, byte color);
+
+// Wait until all queued fills have been drawn. gt_flip(), gt_sync() and
+// gt_wait_vblank() call this, so it is only needed before touching VRAM
+// directly.
+void gt_blit_flush(void);
+
 // Wait for the next vertical blank (frame sync)
 void gt_wait_vblank(void);
 
-// Wait for vblank then immediately flip — ensures the page swap happens
-// during the blanking interval to prevent tearing. Use this instead of
-// separate gt_wait_vblank() + gt_flip() calls.
+// Finish the frame: wait for its blits, then ask the vblank NMI to flip
+// pages and return without waiting for the blank. Game logic for the next
+// frame runs while the flip is pending; the first drawing call waits for
+// it, because until then the new draw page is still on screen. Use this
+// instead of separate gt_wait_vblank() + gt_flip() calls.
 void gt_sync(void);
 
-// Read gamepad state; returns bitmask (test with INPUT_* constants)
+// Change the bits in mask of the banking / DMA flags register to those in
+// value at the next vblank, in order with page flips from gt_sync().
+// Pending blits are finished first. DMA_NMI must stay set.
+void gt_defer_banking(byte mask, byte value);
+void gt_defer_dma_flags(byte mask, byte value);
+
+// Wait until the vblank has applied every pending flip and deferred write
+void gt_defer_wait(void);
+
+// Vblanks since gt_init(), wrapping at 65536
+unsigned gt_frame_count(void);
+
+// Map a ROM bank into $8000-$BFFF. Does nothing if it is already mapped,
+// so calling it before every access to banked data is cheap. Map
+// GT_ROM_BANK_DEFAULT back when done.
+void gt_rom_bank(byte bank);
+
+// Start reading size bytes at offset within bank (offsets past 16KB
+// continue into the following banks)
+void gt_asset_open(struct GTAsset * a, byte bank, unsigned offset, unsigned size);
+
+// Copy the next n bytes of an asset to RAM; returns the number copied,
+// which is less than n at the end of the asset. Reads smaller than
+// GT_ASSET_PREFETCH are served from a read-ahead buffer, larger ones are
+// copied straight from ROM. Maps GT_ROM_BANK_DEFAULT back before
+// returning; within one call, banks switch only where the data crosses.
+unsigned gt_asset_read(struct GTAsset * a, byte * dst, unsigned n);
+
+// Copy the next w x h bytes of an asset into a rectangle of the draw page
+// using direct CPU writes (see gt_plot()); returns the bytes copied.
+// The rectangle must lie on screen. Pixels are stored as VRAM values,
+// i.e. not inverted like GT_* colors.
+unsigned gt_asset_read_vram(struct GTAsset * a, byte x, byte y, byte w, byte h);
+
+// Gamepads are sampled by the vblank NMI, and gt_sync() / gt_wait_vblank()
+// latch the samples for the frame that follows, so these return at once
+// and give the same answer until the next frame. port is 0 or 1; results
+// are bitmasks to test with INPUT_* constants.
+//
+// Buttons down at the last vblank
+unsigned gt_pad_held(byte port);
+
+// Buttons that went down / came up at any vblank since the previous
+// frame, even if they were released / pressed again before it ended
+unsigned gt_pad_pressed(byte port);
+unsigned gt_pad_released(byte port);
+
+// Read gamepad state; returns bitmask (test with INPUT_* constants).
+// Same as gt_pad_held(0).
 unsigned gt_read_gamepad(void);
 
 #pragma compile("gt.c")
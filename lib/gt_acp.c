@@ -0,0 +1,350 @@
+#include "gt_acp.h"
+#include "gt_tables.h"
+
+// Audio RAM layout, in coprocessor addresses (the main CPU reaches the same
+// bytes at gtaram[addr]):
+//   $0000-$001F  worker zero page
+//   $0100-$01FF  worker stack
+//   $0200-       worker code (acp_worker below)
+//   $0400-$0EFF  job data pages
+//   $0F00-$0F17  mailbox: op[8], arg0[8], arg1[8]
+//   $0F18        head, jobs posted (written by the main CPU only)
+//   $0F19        tail, jobs finished (written by the worker only)
+//   $0F20-$0F3F  CORDIC arctangents, low bytes then high bytes
+//   $0FFA-$0FFF  vectors
+// Head and tail are free-running counters; a job's slot is its count & 7.
+#define ACP_CODE      0x0200
+#define ACP_RTI       0x0229    // The worker's rti, for NMI and IRQ
+#define ACP_JOB_OP    0x0F00
+#define ACP_JOB_ARG0  0x0F08
+#define ACP_JOB_ARG1  0x0F10
+#define ACP_HEAD      0x0F18
+#define ACP_TAIL      0x0F19
+#define ACP_ATAN_LO   0x0F20
+#define ACP_ATAN_HI   0x0F30
+#define ACP_VECTORS   0x0FFA
+
+// CORDIC job pages: angles, sines and cosines split into low and high
+// bytes, then the start value and iteration count
+#define ACP_ANGLE_LO  0x000
+#define ACP_ANGLE_HI  0x040
+#define ACP_SIN_LO    0x080
+#define ACP_SIN_HI    0x0C0
+#define ACP_COS_LO    0x100
+#define ACP_COS_HI    0x140
+#define ACP_START     0x180
+#define ACP_ITERS     0x182
+
+// The worker, assembled for $0200. Zero page: W $00, DX $02, DY $04,
+// SX $06, SY $08 (16-bit), IT $0A, ITERS $0B, angle index K $0C, job
+// arguments ARG0/ARG1 $0E/$0F, and P_* pointers to the job's arrays from
+// $10.
+// The CORDIC job follows the C kernel step for step, so both CPUs return
+// identical results; without an unrolled kernel each variable shift costs
+// a loop, and an angle takes about 3000 cycles at 12 iterations.
+static const byte acp_worker[] = {
+	// $0200 reset:
+	0xD8,                   // cld
+	0xA2, 0xFF,             // ldx #$FF
+	0x9A,                   // txs
+	// $0204 idle:
+	// Wait for the head to move past the tail
+	0xAD, 0x19, 0x0F,       // lda ACP_TAIL
+	0xCD, 0x18, 0x0F,       // cmp ACP_HEAD
+	0xF0, 0xF8,             // beq idle
+	// Copy the job's slot into zero page and run it
+	0x29, 0x07,             // and #7
+	0xA8,                   // tay
+	0xB9, 0x08, 0x0F,       // lda ACP_JOB_ARG0,y
+	0x85, 0x0E,             // sta ARG0
+	0xB9, 0x10, 0x0F,       // lda ACP_JOB_ARG1,y
+	0x85, 0x0F,             // sta ARG1
+	0xB9, 0x00, 0x0F,       // lda ACP_JOB_OP,y
+	0x0A,                   // asl
+	0xAA,                   // tax
+	0x20, 0x26, 0x02,       // jsr call
+	// Done: let the main CPU see it
+	0xEE, 0x19, 0x0F,       // inc ACP_TAIL
+	0x80, 0xDE,             // bra idle
+	// $0226 call:
+	0x7C, 0x2A, 0x02,       // jmp (jobs,x)
+	// $0229 irq:
+	0x40,                   // rti
+	// $022A jobs:
+	0x2C, 0x02,             // .word cordic
+	// $022C cordic:
+	// CORDIC: arg0 = angle count, arg1 = first of two data pages
+	0xA5, 0x0F,             // lda ARG1
+	0x85, 0x11,             // sta P_ALO+1
+	0x85, 0x13,             // sta P_AHI+1
+	0x85, 0x15,             // sta P_SLO+1
+	0x85, 0x17,             // sta P_SHI+1
+	0x1A,                   // ina
+	0x85, 0x19,             // sta P_CLO+1
+	0x85, 0x1B,             // sta P_CHI+1
+	0x85, 0x1D,             // sta P_PAR+1
+	0xA9, 0x00,             // lda #$00
+	0x85, 0x10,             // sta P_ALO
+	0x85, 0x18,             // sta P_CLO
+	0xA9, 0x40,             // lda #$40
+	0x85, 0x12,             // sta P_AHI
+	0x85, 0x1A,             // sta P_CHI
+	0xA9, 0x80,             // lda #$80
+	0x85, 0x14,             // sta P_SLO
+	0x85, 0x1C,             // sta P_PAR
+	0xA9, 0xC0,             // lda #$C0
+	0x85, 0x16,             // sta P_SHI
+	// Iteration count
+	0xA0, 0x02,             // ldy #2
+	0xB1, 0x1C,             // lda (P_PAR),y
+	0x85, 0x0B,             // sta ITERS
+	0x64, 0x0C,             // stz K
+	// $025B angle:
+	0xA4, 0x0C,             // ldy K
+	0xC4, 0x0E,             // cpy ARG0
+	0x90, 0x01,             // bcc load
+	0x60,                   // rts
+	// $0262 load:
+	0xB1, 0x10,             // lda (P_ALO),y
+	0x85, 0x00,             // sta W
+	0xB1, 0x12,             // lda (P_AHI),y
+	0x85, 0x01,             // sta W+1
+	0xA0, 0x00,             // ldy #0
+	0xB1, 0x1C,             // lda (P_PAR),y
+	0x85, 0x02,             // sta DX
+	0xC8,                   // iny
+	0xB1, 0x1C,             // lda (P_PAR),y
+	0x85, 0x03,             // sta DX+1
+	0x64, 0x04,             // stz DY
+	0x64, 0x05,             // stz DY+1
+	// Angles beyond +-90 degrees (bits 15 and 14 differ, except +90
+	// itself) turn around: flip the angle's sign bit and negate dx
+	0xA5, 0x01,             // lda W+1
+	0x0A,                   // asl
+	0x45, 0x01,             // eor W+1
+	0x10, 0x1D,             // bpl rotate
+	0xA5, 0x01,             // lda W+1
+	0xC9, 0x40,             // cmp #$40
+	0xD0, 0x04,             // bne flip
+	0xA5, 0x00,             // lda W
+	0xF0, 0x13,             // beq rotate
+	// $028A flip:
+	0xA5, 0x01,             // lda W+1
+	0x49, 0x80,             // eor #$80
+	0x85, 0x01,             // sta W+1
+	0x38,                   // sec
+	0xA9, 0x00,             // lda #0
+	0xE5, 0x02,             // sbc DX
+	0x85, 0x02,             // sta DX
+	0xA9, 0x00,             // lda #0
+	0xE5, 0x03,             // sbc DX+1
+	0x85, 0x03,             // sta DX+1
+	// $029D rotate:
+	// Rotate towards w == 0 with shifts of 0, 1, 2... bits
+	0x64, 0x0A,             // stz IT
+	// $029F step:
+	0xA6, 0x0A,             // ldx IT
+	0xE0, 0x08,             // cpx #8
+	0x90, 0x21,             // bcc copy
+	// Shifts of 8 or more start from the sign-extended high byte
+	0xA5, 0x03,             // lda DX+1
+	0x85, 0x06,             // sta SX
+	0x0A,                   // asl
+	0xA9, 0x00,             // lda #0
+	0xE9, 0x00,             // sbc #0
+	0x49, 0xFF,             // eor #$FF
+	0x85, 0x07,             // sta SX+1
+	0xA5, 0x05,             // lda DY+1
+	0x85, 0x08,             // sta SY
+	0x0A,                   // asl
+	0xA9, 0x00,             // lda #0
+	0xE9, 0x00,             // sbc #0
+	0x49, 0xFF,             // eor #$FF
+	0x85, 0x09,             // sta SY+1
+	0x8A,                   // txa
+	0x38,                   // sec
+	0xE9, 0x08,             // sbc #8
+	0xAA,                   // tax
+	0x80, 0x10,             // bra shift
+	// $02C6 copy:
+	0xA5, 0x02,             // lda DX
+	0x85, 0x06,             // sta SX
+	0xA5, 0x03,             // lda DX+1
+	0x85, 0x07,             // sta SX+1
+	0xA5, 0x04,             // lda DY
+	0x85, 0x08,             // sta SY
+	0xA5, 0x05,             // lda DY+1
+	0x85, 0x09,             // sta SY+1
+	// $02D6 shift:
+	// Arithmetic shift right X bits
+	0xE0, 0x00,             // cpx #0
+	0xF0, 0x11,             // beq shifted
+	0xA5, 0x07,             // lda SX+1
+	0x0A,                   // asl
+	0x66, 0x07,             // ror SX+1
+	0x66, 0x06,             // ror SX
+	0xA5, 0x09,             // lda SY+1
+	0x0A,                   // asl
+	0x66, 0x09,             // ror SY+1
+	0x66, 0x08,             // ror SY
+	0xCA,                   // dex
+	0x80, 0xEB,             // bra shift
+	// $02EB shifted:
+	// w > 0: dx -= sy, dy += sx, w -= atan
+	0xA6, 0x0A,             // ldx IT
+	0xA5, 0x01,             // lda W+1
+	0x30, 0x2F,             // bmi turn
+	0x05, 0x00,             // ora W
+	0xF0, 0x2B,             // beq turn
+	0x38,                   // sec
+	0xA5, 0x02,             // lda DX
+	0xE5, 0x08,             // sbc SY
+	0x85, 0x02,             // sta DX
+	0xA5, 0x03,             // lda DX+1
+	0xE5, 0x09,             // sbc SY+1
+	0x85, 0x03,             // sta DX+1
+	0x18,                   // clc
+	0xA5, 0x04,             // lda DY
+	0x65, 0x06,             // adc SX
+	0x85, 0x04,             // sta DY
+	0xA5, 0x05,             // lda DY+1
+	0x65, 0x07,             // adc SX+1
+	0x85, 0x05,             // sta DY+1
+	0x38,                   // sec
+	0xA5, 0x00,             // lda W
+	0xFD, 0x20, 0x0F,       // sbc ACP_ATAN_LO,x
+	0x85, 0x00,             // sta W
+	0xA5, 0x01,             // lda W+1
+	0xFD, 0x30, 0x0F,       // sbc ACP_ATAN_HI,x
+	0x85, 0x01,             // sta W+1
+	0x80, 0x29,             // bra next
+	// $0320 turn:
+	// w <= 0: dx += sy, dy -= sx, w += atan
+	0x18,                   // clc
+	0xA5, 0x02,             // lda DX
+	0x65, 0x08,             // adc SY
+	0x85, 0x02,             // sta DX
+	0xA5, 0x03,             // lda DX+1
+	0x65, 0x09,             // adc SY+1
+	0x85, 0x03,             // sta DX+1
+	0x38,                   // sec
+	0xA5, 0x04,             // lda DY
+	0xE5, 0x06,             // sbc SX
+	0x85, 0x04,             // sta DY
+	0xA5, 0x05,             // lda DY+1
+	0xE5, 0x07,             // sbc SX+1
+	0x85, 0x05,             // sta DY+1
+	0x18,                   // clc
+	0xA5, 0x00,             // lda W
+	0x7D, 0x20, 0x0F,       // adc ACP_ATAN_LO,x
+	0x85, 0x00,             // sta W
+	0xA5, 0x01,             // lda W+1
+	0x7D, 0x30, 0x0F,       // adc ACP_ATAN_HI,x
+	0x85, 0x01,             // sta W+1
+	// $0349 next:
+	0xE6, 0x0A,             // inc IT
+	0xA5, 0x0A,             // lda IT
+	0xC5, 0x0B,             // cmp ITERS
+	0xF0, 0x03,             // beq store
+	0x4C, 0x9F, 0x02,       // jmp step
+	// $0354 store:
+	// Store sine and cosine, next angle
+	0xA4, 0x0C,             // ldy K
+	0xA5, 0x04,             // lda DY
+	0x91, 0x14,             // sta (P_SLO),y
+	0xA5, 0x05,             // lda DY+1
+	0x91, 0x16,             // sta (P_SHI),y
+	0xA5, 0x02,             // lda DX
+	0x91, 0x18,             // sta (P_CLO),y
+	0xA5, 0x03,             // lda DX+1
+	0x91, 0x1A,             // sta (P_CHI),y
+	0xE6, 0x0C,             // inc K
+	0x4C, 0x5B, 0x02,       // jmp angle
+};
+
+static byte acp_head;
+
+void gt_acp_init(void)
+{
+	// Hold the coprocessor while its program is replaced
+	gtsys.audio_rate = 0;
+
+	for (unsigned i = 0; i < sizeof(acp_worker); i++)
+		gtaram[ACP_CODE + i] = acp_worker[i];
+
+	for (byte i = 0; i < 16; i++)
+	{
+		gtaram[ACP_ATAN_LO + i] = (byte)gt_cordic_atan[i];
+		gtaram[ACP_ATAN_HI + i] = (byte)(gt_cordic_atan[i] >> 8);
+	}
+
+	acp_head = 0;
+	gtaram[ACP_HEAD] = 0;
+	gtaram[ACP_TAIL] = 0;
+
+	gtaram[ACP_VECTORS + 0] = (byte)ACP_RTI;
+	gtaram[ACP_VECTORS + 1] = ACP_RTI >> 8;
+	gtaram[ACP_VECTORS + 2] = (byte)ACP_CODE;
+	gtaram[ACP_VECTORS + 3] = ACP_CODE >> 8;
+	gtaram[ACP_VECTORS + 4] = (byte)ACP_RTI;
+	gtaram[ACP_VECTORS + 5] = ACP_RTI >> 8;
+
+	gtsys.audio_reset = 0;
+	gtsys.audio_rate = GT_ACP_RUN;
+}
+
+byte gt_acp_post(byte op, byte arg0, byte arg1)
+{
+	// The ring is full while the worker is a whole lap behind
+	while ((byte)(acp_head - gtaram[ACP_TAIL]) >= GT_ACP_JOBS)
+		;
+
+	byte slot = acp_head & (GT_ACP_JOBS - 1);
+	gtaram[ACP_JOB_OP + slot] = op;
+	gtaram[ACP_JOB_ARG0 + slot] = arg0;
+	gtaram[ACP_JOB_ARG1 + slot] = arg1;
+
+	// Publish the head only once the slot is complete
+	byte ticket = acp_head++;
+	gtaram[ACP_HEAD] = acp_head;
+	return ticket;
+}
+
+byte gt_acp_done(byte ticket)
+{
+	return (signed char)(gtaram[ACP_TAIL] - ticket) > 0;
+}
+
+void gt_acp_wait(byte ticket)
+{
+	while (!gt_acp_done(ticket))
+		;
+}
+
+byte gt_acp_cordic(byte page, const int * angles, byte n, int start, byte iters)
+{
+	volatile byte * p = gtaram + ((unsigned)page << 8);
+
+	for (byte k = 0; k < n; k++)
+	{
+		int a = angles[k];
+		p[ACP_ANGLE_LO + k] = (byte)a;
+		p[ACP_ANGLE_HI + k] = (byte)(a >> 8);
+	}
+	p[ACP_START + 0] = (byte)start;
+	p[ACP_START + 1] = (byte)(start >> 8);
+	p[ACP_ITERS] = iters;
+
+	return gt_acp_post(GT_ACP_OP_CORDIC, n, page);
+}
+
+void gt_acp_cordic_read(byte page, int * si, int * co, byte n)
+{
+	volatile byte * p = gtaram + ((unsigned)page << 8);
+
+	for (byte k = 0; k < n; k++)
+	{
+		si[k] = p[ACP_SIN_LO + k] | (p[ACP_SIN_HI + k] << 8);
+		co[k] = p[ACP_COS_LO + k] | (p[ACP_COS_HI + k] << 8);
+	}
+}
@@ -0,0 +1,68 @@
+#ifndef GT_ACP_H
+#define GT_ACP_H
+
+// Audio Coprocessor as a Second Core
+// The GameTank's audio coprocessor (ACP) is a full 65C02 with 4KB of RAM
+// that both CPUs can reach. gt_init() leaves it stopped; gt_acp_init()
+// loads a small worker program into its RAM and starts it, so the main CPU
+// can hand off number crunching and keep drawing while the answer is
+// computed. Nothing is played through the DAC while the worker runs.
+//
+// Jobs travel through a ring of GT_ACP_JOBS mailbox slots at the top of
+// audio RAM. gt_acp_post() fills the slot at the head and advances it; the
+// worker runs jobs in order and advances the tail after each one. The
+// returned ticket is done once the tail has passed it. Job data lives in
+// audio RAM pages the caller picks from GT_ACP_PAGE_FIRST up; the main CPU
+// must not touch a job's pages between posting it and its completion.
+//
+// Typical frame:
+//     byte t = gt_acp_cordic(GT_ACP_PAGE_FIRST, angles + 16, 16, start, 12);
+//     ...first 16 angles on the main CPU...
+//     gt_acp_wait(t);
+//     gt_acp_cordic_read(GT_ACP_PAGE_FIRST, si + 16, co + 16, 16);
+
+#include "gt.h"
+
+// audio_rate bit that clocks the coprocessor; gt_acp_init() sets it
+#define GT_ACP_RUN          0x80
+
+// Mailbox slots; at most this many jobs can be queued at once
+#define GT_ACP_JOBS         8
+
+// Audio RAM pages free for job data (coprocessor addresses $0400-$0EFF;
+// add gtaram to reach them from the main CPU)
+#define GT_ACP_PAGE_FIRST   0x04
+#define GT_ACP_PAGE_END     0x0F
+
+// Job opcodes understood by the worker
+#define GT_ACP_OP_CORDIC    0
+
+// Angles in one CORDIC job, which occupies two pages
+#define GT_ACP_CORDIC_MAX   64
+
+// Stop the coprocessor, load the worker and start it with an empty queue
+void gt_acp_init(void);
+
+// Queue a job and return its ticket. Waits for a free slot when all
+// GT_ACP_JOBS are taken.
+byte gt_acp_post(byte op, byte arg0, byte arg1);
+
+// Whether the job with this ticket has finished
+byte gt_acp_done(byte ticket);
+
+// Wait until the job with this ticket has finished
+void gt_acp_wait(byte ticket);
+
+// Queue sine and cosine of n angles (n <= GT_ACP_CORDIC_MAX) with the same
+// CORDIC rotation as the 4260_CordicCircle tutorial: the vector (start, 0)
+// is rotated by each angle (65536 units = full circle) in iters steps
+// (1 to 16), giving start * K * sin and cos with K ~= 1.64676. Uses pages
+// page and page + 1.
+byte gt_acp_cordic(byte page, const int * angles, byte n, int start, byte iters);
+
+// Copy a finished CORDIC job's results out of audio RAM
+void gt_acp_cordic_read(byte page, int * si, int * co, byte n);
+
+#pragma compile("gt_acp.c")
+
+#endif
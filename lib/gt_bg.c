@@ -0,0 +1,65 @@
+#include "gt_bg.h"
+
+void gt_bg_clear(byte color)
+{
+	gt_sprite_fill(GT_BG_GX, GT_BG_GY, GT_SCREEN_W, GT_SCREEN_H, ~color);
+}
+
+void gt_bg_box(byte x, byte y, byte w, byte h, byte color)
+{
+	if (x >= GT_SCREEN_W || y >= GT_SCREEN_H)
+		return;
+	if (w > GT_SCREEN_W - x)
+		w = GT_SCREEN_W - x;
+	if (h > GT_SCREEN_H - y)
+		h = GT_SCREEN_H - y;
+
+	// Sprite RAM holds VRAM values, which the blitter does not invert
+	gt_sprite_fill(GT_BG_GX + x, GT_BG_GY + y, w, h, ~color);
+}
+
+// Copy a w x h rectangle of the background at (gx, gy) to (x, y) in the
+// draw page
+static void bg_copy(byte x, byte y, byte gx, byte gy, byte w, byte h)
+{
+	if (!w || !h)
+		return;
+
+	// A blit covers at most 127x127, so full-width or full-height
+	// rectangles are copied in 64 pixel pieces
+	byte sw = w > 127 ? 64 : w;
+	byte sh = h > 127 ? 64 : h;
+
+	for (byte dy = 0; dy < h; dy += sh)
+	{
+		for (byte dx = 0; dx < w; dx += sw)
+		{
+			gt_blit_sprite(x + dx, y + dy, GT_BG_GX + gx + dx, GT_BG_GY + gy + dy,
+			               sw, sh, GT_SPRITE_OPAQUE);
+		}
+	}
+}
+
+void gt_bg_restore(void)
+{
+	gt_bg_restore_rect(0, 0, GT_SCREEN_W, GT_SCREEN_H);
+}
+
+void gt_bg_restore_rect(byte x, byte y, byte w, byte h)
+{
+	bg_copy(x, y, x, y, w, h);
+}
+
+void gt_bg_restore_wrap(byte sx, byte sy)
+{
+	// Up to four pieces, split where the layer wraps
+	sx &= GT_SCREEN_W - 1;
+	sy &= GT_SCREEN_H - 1;
+	byte w = GT_SCREEN_W - sx;
+	byte h = GT_SCREEN_H - sy;
+
+	bg_copy(0, 0, sx, sy, w, h);
+	bg_copy(w, 0, 0, sy, sx, h);
+	bg_copy(0, h, sx, 0, w, sy);
+	bg_copy(w, h, 0, 0, sx, sy);
+}
@@ -0,0 +1,54 @@
+#ifndef GT_BG_H
+#define GT_BG_H
+
+// Background Layer
+// Keeps a full-screen static background in one 128x128 quadrant of sprite
+// RAM. The scene is drawn into it once, by the CPU, and then copied into
+// the draw page by the blitter whenever it is needed: the whole screen
+// with gt_bg_restore() (four 64x64 copies, the same blitter time as
+// gt_clear()), or just the areas moving objects covered with
+// gt_dirty_restore(). However detailed the background is, putting it back
+// costs the same.
+//
+// Setup:
+//     gt_bg_clear(GT_BLUE);
+//     gt_bg_box(x, y, w, h, GT_DARK_GRAY);    // scenery
+//     gt_bg_restore(); gt_flip();             // paint both pages
+//     gt_bg_restore(); gt_flip();
+//
+// Typical frame:
+//     gt_dirty_restore();                     // instead of gt_dirty_clear()
+//     gt_dirty_box(x, y, w, h, color);
+//     gt_sync();
+
+#include "gt.h"
+
+// Sprite RAM quadrant holding the background; the others stay free for
+// sprites
+#define GT_BG_GX  128
+#define GT_BG_GY  128
+
+// Fill the whole background with a color (GT_* value)
+void gt_bg_clear(byte color);
+
+// Draw a filled rectangle into the background. Writes sprite RAM with the
+// CPU, so this is for setting a scene up, not for per-frame drawing.
+void gt_bg_box(byte x, byte y, byte w, byte h, byte color);
+
+// Copy the whole background into the draw page
+void gt_bg_restore(void);
+
+// Copy one rectangle of the background into the same place in the draw
+// page; w and h may be up to 128
+void gt_bg_restore_rect(byte x, byte y, byte w, byte h);
+
+// Copy the whole background with the layer used as a ring: its pixel
+// (sx, sy) lands in the top-left corner of the screen, and what runs off
+// the right or bottom edge continues from the left or top. A scrolling
+// view then only has to draw the strip it uncovers into the layer. Still
+// four blits.
+void gt_bg_restore_wrap(byte sx, byte sy);
+
+#pragma compile("gt_bg.c")
+
+#endif
@@ -0,0 +1,125 @@
+#include "gt_dirty.h"
+#include "gt_bg.h"
+
+// Rectangles per page as parallel arrays indexed by page * GT_DIRTY_MAX + i.
+// Corners are stored as [x0, x1) x [y0, y1) so unions are plain min/max.
+static byte dirty_x0[2 * GT_DIRTY_MAX];
+static byte dirty_y0[2 * GT_DIRTY_MAX];
+static byte dirty_x1[2 * GT_DIRTY_MAX];
+static byte dirty_y1[2 * GT_DIRTY_MAX];
+static byte dirty_count[2];
+
+// Page being recorded and its first slot
+static byte dirty_page;
+static byte dirty_base;
+
+// Fill a rectangle that may be a full 128 pixels wide or high. The blitter
+// handles at most 127x127, so such rectangles are split into 64 pixel halves.
+static void dirty_fill(byte x, byte y, byte w, byte h, byte color)
+{
+	byte sw = w > 127 ? 64 : w;
+	byte sh = h > 127 ? 64 : h;
+
+	for (byte dy = 0; dy < h; dy += sh)
+	{
+		for (byte dx = 0; dx < w; dx += sw)
+			gt_draw_box(x + dx, y + dy, sw, sh, color);
+	}
+}
+
+// Switch recording to the current draw page; returns how many rectangles
+// it holds from last time. They stay readable until the next mark.
+static byte dirty_begin(void)
+{
+	dirty_page = gt_draw_page();
+	dirty_base = dirty_page * GT_DIRTY_MAX;
+
+	byte n = dirty_count[dirty_page];
+	dirty_count[dirty_page] = 0;
+	return n;
+}
+
+void gt_dirty_clear(byte color)
+{
+	byte n = dirty_begin();
+	for (byte i = 0; i < n; i++)
+	{
+		byte j = dirty_base + i;
+		dirty_fill(dirty_x0[j], dirty_y0[j],
+		           dirty_x1[j] - dirty_x0[j], dirty_y1[j] - dirty_y0[j], color);
+	}
+}
+
+void gt_dirty_restore(void)
+{
+	byte n = dirty_begin();
+	for (byte i = 0; i < n; i++)
+	{
+		byte j = dirty_base + i;
+		gt_bg_restore_rect(dirty_x0[j], dirty_y0[j],
+		                   dirty_x1[j] - dirty_x0[j], dirty_y1[j] - dirty_y0[j]);
+	}
+}
+
+void gt_dirty_mark(byte x, byte y, byte w, byte h)
+{
+	if (x >= GT_SCREEN_W || y >= GT_SCREEN_H || w == 0 || h == 0)
+		return;
+
+	// Clip to the screen so the right/bottom edges fit in a byte
+	byte x1 = w > GT_SCREEN_W - x ? GT_SCREEN_W : x + w;
+	byte y1 = h > GT_SCREEN_H - y ? GT_SCREEN_H : y + h;
+
+	byte n = dirty_count[dirty_page];
+
+	// Absorb every recorded rectangle that overlaps the new one. Absorbing
+	// grows the new rectangle, so rescan from the start after each merge.
+	// The absorbed slot is refilled from the end of the list.
+	byte i = 0;
+	while (i < n)
+	{
+		byte j = dirty_base + i;
+		if (x < dirty_x1[j] && dirty_x0[j] < x1 &&
+		    y < dirty_y1[j] && dirty_y0[j] < y1)
+		{
+			if (dirty_x0[j] < x)  x = dirty_x0[j];
+			if (dirty_y0[j] < y)  y = dirty_y0[j];
+			if (dirty_x1[j] > x1) x1 = dirty_x1[j];
+			if (dirty_y1[j] > y1) y1 = dirty_y1[j];
+
+			n--;
+			byte k = dirty_base + n;
+			dirty_x0[j] = dirty_x0[k];
+			dirty_y0[j] = dirty_y0[k];
+			dirty_x1[j] = dirty_x1[k];
+			dirty_y1[j] = dirty_y1[k];
+			i = 0;
+		}
+		else
+			i++;
+	}
+
+	// List full: fold the last rectangle into the new one
+	if (n == GT_DIRTY_MAX)
+	{
+		n--;
+		byte k = dirty_base + n;
+		if (dirty_x0[k] < x)  x = dirty_x0[k];
+		if (dirty_y0[k] < y)  y = dirty_y0[k];
+		if (dirty_x1[k] > x1) x1 = dirty_x1[k];
+		if (dirty_y1[k] > y1) y1 = dirty_y1[k];
+	}
+
+	byte k = dirty_base + n;
+	dirty_x0[k] = x;
+	dirty_y0[k] = y;
+	dirty_x1[k] = x1;
+	dirty_y1[k] = y1;
+	dirty_count[dirty_page] = n + 1;
+}
+
+void gt_dirty_box(byte x, byte y, byte w, byte h, byte color)
+{
+	gt_dirty_mark(x, y, w, h);
+	gt_draw_box(x, y, w, h, color);
+}
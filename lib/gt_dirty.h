@@ -0,0 +1,36 @@
+#ifndef GT_DIRTY_H
+#define GT_DIRTY_H
+
+// Dirty-Rectangle Renderer
+// Remembers which rectangles were drawn into each framebuffer page, so the
+// next frame on that page erases only those areas instead of the whole
+// screen. Overlapping rectangles are coalesced into their bounding box.
+//
+// Typical frame:
+//     gt_dirty_clear(GT_BLACK);           // instead of gt_clear()
+//     gt_draw_box(...);                   // static scenery, not recorded
+//     gt_dirty_box(x, y, w, h, color);    // moving objects
+//     gt_sync();
+
+#include "gt.h"
+
+// Rectangles remembered per page; further rectangles are merged into the
+// last one, which stays correct but erases more than needed
+#define GT_DIRTY_MAX  16
+
+// Erase the rectangles recorded the last time the current draw page was
+// drawn, and start recording for this frame
+void gt_dirty_clear(byte color);
+
+// Same, but put back the background layer from gt_bg.h instead of a color
+void gt_dirty_restore(void);
+
+// Record a rectangle to erase the next time this page is drawn
+void gt_dirty_mark(byte x, byte y, byte w, byte h);
+
+// Draw a filled rectangle and record it
+void gt_dirty_box(byte x, byte y, byte w, byte h, byte color);
+
+#pragma compile("gt_dirty.c")
+
+#endif
@@ -0,0 +1,52 @@
+#include "gt_fixmath.h"
+#include "gt_tables.h"
+
+unsigned gt_umul8(byte a, byte b)
+{
+	byte d = a >= b ? a - b : b - a;
+	return gt_qsqr[(unsigned)a + b] - gt_qsqr[d];
+}
+
+int gt_smul8(signed char a, signed char b)
+{
+	byte ua = a < 0 ? -a : a;
+	byte ub = b < 0 ? -b : b;
+	int p = gt_umul8(ua, ub);
+	return (a ^ b) < 0 ? -p : p;
+}
+
+// Magnitude of a 16-bit value times a byte, >> 8
+static unsigned scale_mag(unsigned m, byte b)
+{
+	return gt_umul8(m >> 8, b) + (gt_umul8(m & 0xff, b) >> 8);
+}
+
+int gt_fix_scale(int a, byte b)
+{
+	if (a < 0)
+		return -(int)scale_mag(-a, b);
+	return scale_mag(a, b);
+}
+
+int gt_fix_sscale(int a, signed char b)
+{
+	if (b < 0)
+		return -gt_fix_scale(a, (byte)-b);
+	return gt_fix_scale(a, b);
+}
+
+gt_fix gt_fix_mul(gt_fix a, gt_fix b)
+{
+	unsigned ua = a < 0 ? -a : a;
+	unsigned ub = b < 0 ? -b : b;
+
+	// (ah:al * bh:bl) >> 8 from the four byte products
+	byte ah = ua >> 8, al = ua & 0xff;
+	byte bh = ub >> 8, bl = ub & 0xff;
+	unsigned p = (gt_umul8(ah, bh) << 8)
+	           + gt_umul8(ah, bl)
+	           + gt_umul8(al, bh)
+	           + (gt_umul8(al, bl) >> 8);
+
+	return (a ^ b) < 0 ? -(int)p : (int)p;
+}
@@ -0,0 +1,58 @@
+#ifndef GT_FIXMATH_H
+#define GT_FIXMATH_H
+
+// Fixed-Point Math
+// Signed 8.8 fixed point without 32-bit arithmetic. The 65C02 has no
+// multiply instruction, so casting to long costs a 32-step software
+// multiply. Here products of bytes come from the quarter-square table
+// in gt_tables.h:
+//     a * b = gt_qsqr[a + b] - gt_qsqr[|a - b|]
+// which is two table reads and a subtraction, and wider products are
+// built from byte products. Scaling by constants of the form 1 +- 2^-n
+// needs no multiply at all; see GT_FIX_DAMP / GT_FIX_BOOST.
+//
+// Typical use:
+//     gt_fix x = GT_FIX(3);                  // 3.0
+//     x = gt_fix_mul(x, GT_FIX_HALF);        // 1.5
+//     int px = gt_fix_scale(ux, RADIUS);     // RADIUS * ux as an integer
+
+#include "gt.h"
+
+// Signed 8.8: 8 integer bits, 8 fraction bits
+typedef int gt_fix;
+
+#define GT_FIX_BITS   8
+#define GT_FIX_ONE    (1 << GT_FIX_BITS)
+#define GT_FIX_HALF   (GT_FIX_ONE / 2)
+
+// Integer to 8.8, and back (rounding down or to nearest)
+#define GT_FIX(n)         ((gt_fix)((n) << GT_FIX_BITS))
+#define GT_FIX_INT(f)     ((f) >> GT_FIX_BITS)
+#define GT_FIX_ROUND(f)   (((f) + GT_FIX_HALF) >> GT_FIX_BITS)
+#define GT_FIX_FRAC(f)    ((byte)(f))
+
+// v * (1 - 2^-n) and v * (1 + 2^-n), e.g. GT_FIX_DAMP(v, 3) = 7/8 v
+#define GT_FIX_DAMP(v, n)   ((v) - ((v) >> (n)))
+#define GT_FIX_BOOST(v, n)  ((v) + ((v) >> (n)))
+
+// Unsigned 8 x 8 -> 16 bit product
+unsigned gt_umul8(byte a, byte b);
+
+// Signed 8 x 8 -> 16 bit product
+int gt_smul8(signed char a, signed char b);
+
+// (a * b) >> 8 for a signed 16-bit a and an unsigned byte b, i.e. a
+// scaled by b / 256. With a in 8.8 and b a plain integer, the result is
+// the integer a * b. Rounds toward zero.
+int gt_fix_scale(int a, byte b);
+
+// (a * b) >> 8 for a signed byte b, e.g. a unit 8.8 vector component
+// times a gt_sin40 entry gives that multiple of the vector in pixels
+int gt_fix_sscale(int a, signed char b);
+
+// 8.8 x 8.8 -> 8.8 product. Rounds toward zero; overflow wraps.
+gt_fix gt_fix_mul(gt_fix a, gt_fix b);
+
+#pragma compile("gt_fixmath.c")
+
+#endif
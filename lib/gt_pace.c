@@ -0,0 +1,73 @@
+#include "gt_pace.h"
+
+unsigned gt_pace_frames;
+unsigned gt_pace_missed;
+unsigned gt_pace_dropped;
+
+static unsigned pace_last;   // Frame count at the previous gt_pace_sync()
+static byte pace_owed;       // Steps not yet handed out
+static byte pace_max;
+static byte pace_ahead;      // Vblanks gt_pace_sync() reported early
+
+void gt_pace_init(byte max_steps)
+{
+	pace_max = max_steps;
+	pace_owed = 1;
+	gt_pace_frames = 0;
+	gt_pace_missed = 0;
+	gt_pace_dropped = 0;
+	pace_ahead = 0;
+	pace_last = gt_frame_count();
+}
+
+byte gt_pace_sync(void)
+{
+	// gt_sync() returns once the previous flip has happened and this one
+	// is queued, so the frame counter now points at the vblank before this
+	// frame's flip. Successive differences are the flip-to-flip times; a
+	// vblank landing just before the read moves one from this frame to the
+	// next, but the sum stays exact.
+	gt_sync();
+
+	unsigned now = gt_frame_count();
+	unsigned elapsed = now - pace_last;
+	pace_last = now;
+	if (elapsed > 255)
+		elapsed = 255;
+
+	gt_pace_frames++;
+	if (elapsed > 1)
+		gt_pace_missed += elapsed - 1;
+
+	unsigned owed = pace_owed + elapsed;
+	pace_owed = owed > 255 ? 255 : (byte)owed;
+
+	// Callers scale motion by the result, so a frame that lost its vblank
+	// to the next one still reports 1; the next longer frame reports one
+	// less to keep the sum exact
+	byte ret = (byte)elapsed;
+	if (!ret)
+	{
+		ret = 1;
+		pace_ahead++;
+	}
+	else if (ret > 1 && pace_ahead)
+	{
+		ret--;
+		pace_ahead--;
+	}
+	return ret;
+}
+
+byte gt_pace_steps(void)
+{
+	byte n = pace_owed;
+	pace_owed = 0;
+
+	if (n > pace_max)
+	{
+		gt_pace_dropped += n - pace_max;
+		n = pace_max;
+	}
+	return n;
+}
@@ -0,0 +1,52 @@
+#ifndef GT_PACE_H
+#define GT_PACE_H
+
+// Frame Pacing
+// Measures how many vblanks each frame took, using the NMI frame counter,
+// so a program can keep its simulation running at 60 updates per second
+// even when a frame takes too long to draw. In fixed-timestep mode the
+// main loop asks how many update steps it owes and runs them all before
+// drawing once; the states in between are never drawn, so heavy load
+// lowers the frame rate instead of slowing the game down.
+//
+// Typical frame:
+//     for (byte n = gt_pace_steps(); n; n--)
+//         update();                   // one 1/60s step
+//     draw();
+//     gt_pace_sync();                 // instead of gt_sync()
+
+#include "gt.h"
+
+// Steps gt_pace_steps() hands out at most; anything beyond is dropped, and
+// the game slows down rather than spending ever longer catching up
+#define GT_PACE_MAX_STEPS  4
+
+// Frames flipped since gt_pace_init()
+extern unsigned gt_pace_frames;
+
+// Vblanks at which no new frame was ready, so the last one stayed on
+// screen for another 1/60s
+extern unsigned gt_pace_missed;
+
+// Update steps dropped because more than max_steps were owed
+extern unsigned gt_pace_dropped;
+
+// Start pacing from the current vblank and clear the counters. max_steps
+// (1 to 255, usually GT_PACE_MAX_STEPS) limits gt_pace_steps().
+void gt_pace_init(byte max_steps);
+
+// gt_sync(), then account for the time the frame took. Returns the vblanks
+// since the previous call: 1 when the frame was on time, more after missed
+// vblanks. Never 0: a frame whose vblank is counted with the next one
+// still reports 1, and a later long frame reports one less, so the results
+// still add up. Variable-timestep code can scale its motion by this.
+byte gt_pace_sync(void);
+
+// Update steps to run before drawing the next frame: the vblanks that have
+// passed since the steps were last handed out, at most max_steps. Returns
+// 1 at the start.
+byte gt_pace_steps(void);
+
+#pragma compile("gt_pace.c")
+
+#endif
@@ -0,0 +1,82 @@
+#include "gt_phys.h"
+#include "gt_fixmath.h"
+
+int __striped gt_phys_x[GT_PHYS_MAX];
+int __striped gt_phys_y[GT_PHYS_MAX];
+int __striped gt_phys_vx[GT_PHYS_MAX];
+int __striped gt_phys_vy[GT_PHYS_MAX];
+
+byte gt_phys_count;
+
+void gt_phys_init(byte count)
+{
+	gt_phys_count = count;
+	for (byte i = 0; i < count; i++)
+	{
+		gt_phys_x[i] = 0;
+		gt_phys_y[i] = 0;
+		gt_phys_vx[i] = 0;
+		gt_phys_vy[i] = 0;
+	}
+}
+
+void gt_phys_integrate(void)
+{
+	byte n = gt_phys_count;
+	for (byte i = 0; i < n; i++)
+	{
+		gt_phys_x[i] += gt_phys_vx[i];
+		gt_phys_y[i] += gt_phys_vy[i];
+	}
+}
+
+void gt_phys_apply_gravity(int g)
+{
+	byte n = gt_phys_count;
+	for (byte i = 0; i < n; i++)
+		gt_phys_vy[i] += g;
+}
+
+void gt_phys_bounce_walls(int max_x, int max_y, byte floor_damp)
+{
+	byte n = gt_phys_count;
+	for (byte i = 0; i < n; i++)
+	{
+		// Only flip velocities that still point out of the screen, so an
+		// object clamped to an edge never gets stuck flipping back and forth
+		int x = gt_phys_x[i];
+		if (x < 0)
+		{
+			gt_phys_x[i] = 0;
+			if (gt_phys_vx[i] < 0)
+				gt_phys_vx[i] = -gt_phys_vx[i];
+		}
+		else if (x > max_x)
+		{
+			gt_phys_x[i] = max_x;
+			if (gt_phys_vx[i] > 0)
+				gt_phys_vx[i] = -gt_phys_vx[i];
+		}
+
+		int y = gt_phys_y[i];
+		if (y < 0)
+		{
+			gt_phys_y[i] = 0;
+			if (gt_phys_vy[i] < 0)
+				gt_phys_vy[i] = -gt_phys_vy[i];
+		}
+		else if (y > max_y)
+		{
+			gt_phys_y[i] = max_y;
+			int vy = gt_phys_vy[i];
+			if (vy > 0)
+			{
+				// A speed too small to lose anything to damping would
+				// bounce at sub-pixel height forever; stop it instead
+				if (floor_damp)
+					vy = (vy >> floor_damp) ? GT_FIX_DAMP(vy, floor_damp) : 0;
+				gt_phys_vy[i] = -vy;
+			}
+		}
+	}
+}
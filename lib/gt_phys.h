@@ -0,0 +1,56 @@
+#ifndef GT_PHYS_H
+#define GT_PHYS_H
+
+// Fixed-Point Box Physics
+// Positions and velocities of up to GT_PHYS_MAX objects, stored as
+// struct-of-arrays in 8.8 fixed point. The arrays are __striped, so the
+// low and high bytes of each value live in separate byte arrays and the
+// kernels index them with a byte register (abs,X) instead of multiplying
+// the index by a struct size. With 8 fraction bits the pixel coordinate is
+// simply the high byte.
+//
+// Each kernel processes all objects in one loop:
+//     gt_phys_apply_gravity(g);       // vy += g
+//     gt_phys_integrate();            // x += vx, y += vy
+//     gt_phys_bounce_walls(mx, my, 0);// reflect at the screen edges
+
+#include "gt.h"
+
+#define GT_PHYS_MAX    64
+#define GT_PHYS_FBITS  8
+#define GT_PHYS_ONE    (1 << GT_PHYS_FBITS)
+
+// Largest position that keeps an object of the given pixel size on screen
+#define GT_PHYS_MAX_X(size)  ((GT_SCREEN_W - (size) - 1) << GT_PHYS_FBITS)
+#define GT_PHYS_MAX_Y(size)  ((GT_SCREEN_H - (size) - 1) << GT_PHYS_FBITS)
+
+// Pixel coordinates of object i
+#define GT_PHYS_PX(i)  ((byte)(gt_phys_x[i] >> GT_PHYS_FBITS))
+#define GT_PHYS_PY(i)  ((byte)(gt_phys_y[i] >> GT_PHYS_FBITS))
+
+extern int __striped gt_phys_x[GT_PHYS_MAX];
+extern int __striped gt_phys_y[GT_PHYS_MAX];
+extern int __striped gt_phys_vx[GT_PHYS_MAX];
+extern int __striped gt_phys_vy[GT_PHYS_MAX];
+
+// Number of objects the kernels process
+extern byte gt_phys_count;
+
+// Zero count objects and make them active
+void gt_phys_init(byte count);
+
+// Add velocity to position
+void gt_phys_integrate(void);
+
+// Add g to every vertical velocity
+void gt_phys_apply_gravity(int g);
+
+// Clamp positions to [0, max_x] x [0, max_y] and reflect the velocity of
+// objects that hit an edge. When floor_damp is nonzero, hitting the bottom
+// edge also removes 1 / 2^floor_damp of the vertical speed, and a speed
+// below 2^floor_damp stops dead, so resting objects settle.
+void gt_phys_bounce_walls(int max_x, int max_y, byte floor_damp);
+
+#pragma compile("gt_phys.c")
+
+#endif
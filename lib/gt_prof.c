@@ -0,0 +1,99 @@
+#include "gt_prof.h"
+
+// Timer value at gt_prof_begin(), cycles so far this frame, and the
+// totals of the last completed frame
+static unsigned prof_start[GT_PROF_ZONES];
+static unsigned prof_acc[GT_PROF_ZONES];
+static unsigned prof_last[GT_PROF_ZONES];
+
+// Bar color for each zone
+static const byte prof_color[GT_PROF_ZONES] = {
+	GT_BLUE, GT_GREEN, GT_ORANGE, GT_DARK_GRAY,
+	GT_RED, GT_MAGENTA, GT_CYAN, GT_YELLOW
+};
+
+// Read the T1 counter. The low byte can borrow from the high byte between
+// the two reads, so retry until the high byte is stable.
+static unsigned prof_now(void)
+{
+	byte hi, lo;
+	do
+	{
+		hi = gtvia.t1ch;
+		lo = gtvia.t1cl;
+	} while (hi != gtvia.t1ch);
+
+	return (unsigned)hi << 8 | lo;
+}
+
+void gt_prof_init(void)
+{
+	// T1 free-running (ACR bit 6) without PB7 output, interrupt disabled
+	gtvia.ier = 0x40;
+	gtvia.acr = (gtvia.acr & 0x3F) | 0x40;
+
+	// Writing the high counter byte loads the latch and starts counting
+	gtvia.t1cl = 0xFF;
+	gtvia.t1ch = 0xFF;
+
+	for (byte i = 0; i < GT_PROF_ZONES; i++)
+	{
+		prof_acc[i] = 0;
+		prof_last[i] = 0;
+	}
+}
+
+void gt_prof_begin(byte id)
+{
+	prof_start[id] = prof_now();
+}
+
+void gt_prof_end(byte id)
+{
+	// T1 counts down, so elapsed = start - now (mod 65536). Saturate the
+	// total so an overrunning frame shows a full bar instead of wrapping.
+	unsigned elapsed = prof_start[id] - prof_now();
+	unsigned total = prof_acc[id] + elapsed;
+	prof_acc[id] = total < elapsed ? 0xFFFF : total;
+}
+
+void gt_prof_sync(void)
+{
+	gt_prof_begin(GT_PROF_SYNC);
+	gt_sync();
+	gt_prof_end(GT_PROF_SYNC);
+
+	for (byte i = 0; i < GT_PROF_ZONES; i++)
+	{
+		prof_last[i] = prof_acc[i];
+		prof_acc[i] = 0;
+	}
+}
+
+unsigned gt_prof_cycles(byte id)
+{
+	return prof_last[id];
+}
+
+void gt_prof_overlay(void)
+{
+	// Background strip, then one segment per zone
+	gt_draw_box(0, GT_PROF_BAR_Y, 127, GT_PROF_BAR_H, GT_BLACK);
+
+	byte x = 0;
+	for (byte i = 0; i < GT_PROF_ZONES; i++)
+	{
+		unsigned w = prof_last[i] >> GT_PROF_SHIFT;
+		if (w > 127 - x)
+			w = 127 - x;
+		if (w)
+		{
+			gt_draw_box(x, GT_PROF_BAR_Y, (byte)w, GT_PROF_BAR_H, prof_color[i]);
+			x += (byte)w;
+		}
+	}
+
+	// Frame budget tick
+	gt_draw_box(GT_PROF_FRAME_CYCLES >> GT_PROF_SHIFT, GT_PROF_BAR_Y - 1,
+	            1, GT_PROF_BAR_H + 1, GT_WHITE);
+}
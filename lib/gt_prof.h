@@ -0,0 +1,54 @@
+#ifndef GT_PROF_H
+#define GT_PROF_H
+
+// Frame Profiler
+// Measures how many CPU cycles each part of a frame takes using VIA timer
+// T1, which counts down once per CPU cycle. Wrap code in
+// gt_prof_begin(id) / gt_prof_end(id), replace gt_sync() with
+// gt_prof_sync(), and call gt_prof_overlay() before it to see the previous
+// frame's totals as a stacked bar along the bottom of the screen.
+//
+// Drawing calls only queue blits, so a blitter-bound frame shows a short
+// draw zone followed by a long sync zone (waiting for the queue to drain),
+// while a CPU-bound frame has almost no sync time. gt_sync() does not wait
+// for vblank; that wait lands in the zone holding the frame's first
+// drawing call, which has to wait for the flip.
+
+#include "gt.h"
+
+// Predefined zones; ids up to GT_PROF_ZONES - 1 are free for other uses
+#define GT_PROF_CLEAR    0
+#define GT_PROF_PHYSICS  1
+#define GT_PROF_DRAW     2
+#define GT_PROF_SYNC     3
+#define GT_PROF_ZONES    8
+
+// CPU cycles in one 60Hz frame (3.579545 MHz / 60)
+#define GT_PROF_FRAME_CYCLES  59659u
+
+// The overlay bar draws one pixel per 512 cycles, so a full frame is
+// 116 pixels wide. A white tick marks the end of the frame budget.
+#define GT_PROF_SHIFT    9
+#define GT_PROF_BAR_Y    (GT_SCREEN_H - 5)
+#define GT_PROF_BAR_H    4
+
+// Start T1 free-running and clear all zones
+void gt_prof_init(void);
+
+// Start and stop timing a zone. A zone may be entered several times per
+// frame; its cycles accumulate until the next gt_prof_sync().
+void gt_prof_begin(byte id);
+void gt_prof_end(byte id);
+
+// gt_sync() timed as GT_PROF_SYNC, then start a new profiling frame
+void gt_prof_sync(void);
+
+// Cycles a zone took in the last completed frame
+unsigned gt_prof_cycles(byte id);
+
+// Draw the last completed frame's zones as a stacked bar
+void gt_prof_overlay(void);
+
+#pragma compile("gt_prof.c")
+
+#endif
@@ -0,0 +1,67 @@
+#include "gt_sweep.h"
+
+// Bounds per object id as [x0, x1) x [y0, y1), and object ids sorted by x0
+static byte sweep_x0[GT_SWEEP_MAX];
+static byte sweep_x1[GT_SWEEP_MAX];
+static byte sweep_y0[GT_SWEEP_MAX];
+static byte sweep_y1[GT_SWEEP_MAX];
+static byte sweep_order[GT_SWEEP_MAX];
+static byte sweep_count;
+
+void gt_sweep_init(byte count)
+{
+	sweep_count = count;
+	for (byte i = 0; i < count; i++)
+	{
+		sweep_order[i] = i;
+		sweep_x0[i] = sweep_x1[i] = 0;
+		sweep_y0[i] = sweep_y1[i] = 0;
+	}
+}
+
+void gt_sweep_set(byte id, byte x, byte y, byte w, byte h)
+{
+	sweep_x0[id] = x;
+	sweep_x1[id] = x + w;
+	sweep_y0[id] = y;
+	sweep_y1[id] = y + h;
+}
+
+void gt_sweep_pairs(GTSweepPairFn pair)
+{
+	byte n = sweep_count;
+
+	// Insertion sort by left edge. Last frame's order is nearly right, so
+	// most objects move zero or one slot.
+	for (byte i = 1; i < n; i++)
+	{
+		byte id = sweep_order[i];
+		byte x = sweep_x0[id];
+		byte j = i;
+		while (j > 0 && sweep_x0[sweep_order[j - 1]] > x)
+		{
+			sweep_order[j] = sweep_order[j - 1];
+			j--;
+		}
+		sweep_order[j] = id;
+	}
+
+	// Sweep: compare each box only with the boxes that start before its
+	// right edge, then check the Y interval
+	for (byte i = 0; i < n; i++)
+	{
+		byte a = sweep_order[i];
+		byte ax1 = sweep_x1[a];
+		byte ay0 = sweep_y0[a];
+		byte ay1 = sweep_y1[a];
+
+		for (byte j = i + 1; j < n; j++)
+		{
+			byte b = sweep_order[j];
+			if (sweep_x0[b] >= ax1)
+				break;
+			if (sweep_y0[b] < ay1 && ay0 < sweep_y1[b])
+				pair(a, b);
+		}
+	}
+}
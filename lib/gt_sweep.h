@@ -0,0 +1,35 @@
+#ifndef GT_SWEEP_H
+#define GT_SWEEP_H
+
+// Sweep-and-Prune Broadphase
+// Finds overlapping pairs among many axis-aligned boxes without testing
+// every pair. Boxes are kept sorted by their left edge; each box is only
+// compared against the boxes that start before its right edge ends.
+// Objects move a little each frame, so the order from the previous frame
+// is nearly sorted and the insertion sort that restores it runs in close
+// to linear time. Coordinates are 8-bit pixels.
+//
+// Typical frame:
+//     for (i = 0; i < n; i++)
+//         gt_sweep_set(i, x[i], y[i], w, h);
+//     gt_sweep_pairs(on_overlap);
+
+#include "gt.h"
+
+#define GT_SWEEP_MAX  128
+
+// Called once for every overlapping pair of object ids
+typedef void (*GTSweepPairFn)(byte a, byte b);
+
+// Track objects 0 .. count-1
+void gt_sweep_init(byte count);
+
+// Set an object's bounding box for this frame
+void gt_sweep_set(byte id, byte x, byte y, byte w, byte h);
+
+// Re-sort along X and report every overlapping pair
+void gt_sweep_pairs(GTSweepPairFn pair);
+
+#pragma compile("gt_sweep.c")
+
+#endif
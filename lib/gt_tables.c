@@ -0,0 +1,134 @@
+// Shared lookup tables — GENERATED by tools/gttab, do not edit.
+
+#include "gt_tables.h"
+
+const signed char gt_sin40[256] = {
+	   0,    1,    2,    3,    4,    5,    6,    7,    8,    9,   10,   11,   12,   13,   13,   14,
+	  15,   16,   17,   18,   19,   20,   21,   21,   22,   23,   24,   25,   25,   26,   27,   28,
+	  28,   29,   30,   30,   31,   32,   32,   33,   33,   34,   34,   35,   35,   36,   36,   37,
+	  37,   37,   38,   38,   38,   39,   39,   39,   39,   39,   40,   40,   40,   40,   40,   40,
+	  40,   40,   40,   40,   40,   40,   40,   39,   39,   39,   39,   39,   38,   38,   38,   37,
+	  37,   37,   36,   36,   35,   35,   34,   34,   33,   33,   32,   32,   31,   30,   30,   29,
+	  28,   28,   27,   26,   25,   25,   24,   23,   22,   21,   21,   20,   19,   18,   17,   16,
+	  15,   14,   13,   13,   12,   11,   10,    9,    8,    7,    6,    5,    4,    3,    2,    1,
+	   0,   -1,   -2,   -3,   -4,   -5,   -6,   -7,   -8,   -9,  -10,  -11,  -12,  -13,  -13,  -14,
+	 -15,  -16,  -17,  -18,  -19,  -20,  -21,  -21,  -22,  -23,  -24,  -25,  -25,  -26,  -27,  -28,
+	 -28,  -29,  -30,  -30,  -31,  -32,  -32,  -33,  -33,  -34,  -34,  -35,  -35,  -36,  -36,  -37,
+	 -37,  -37,  -38,  -38,  -38,  -39,  -39,  -39,  -39,  -39,  -40,  -40,  -40,  -40,  -40,  -40,
+	 -40,  -40,  -40,  -40,  -40,  -40,  -40,  -39,  -39,  -39,  -39,  -39,  -38,  -38,  -38,  -37,
+	 -37,  -37,  -36,  -36,  -35,  -35,  -34,  -34,  -33,  -33,  -32,  -32,  -31,  -30,  -30,  -29,
+	 -28,  -28,  -27,  -26,  -25,  -25,  -24,  -23,  -22,  -21,  -21,  -20,  -19,  -18,  -17,  -16,
+	 -15,  -14,  -13,  -13,  -12,  -11,  -10,   -9,   -8,   -7,   -6,   -5,   -4,   -3,   -2,   -1
+};
+
+const int __striped gt_cordic_atan[16] = {
+	  8192,   4836,   2555,   1297,    651,    326,    163,     81,     41,     20,     10,      5,      3,      1,      1,      0
+};
+
+const unsigned __striped gt_recip[256] = {
+	 65535,  65535,  32768,  21845,  16384,  13107,  10923,   9362,   8192,   7282,   6554,   5958,   5461,   5041,   4681,   4369,
+	  4096,   3855,   3641,   3449,   3277,   3121,   2979,   2849,   2731,   2621,   2521,   2427,   2341,   2260,   2185,   2114,
+	  2048,   1986,   1928,   1872,   1820,   1771,   1725,   1680,   1638,   1598,   1560,   1524,   1489,   1456,   1425,   1394,
+	  1365,   1337,   1311,   1285,   1260,   1237,   1214,   1192,   1170,   1150,   1130,   1111,   1092,   1074,   1057,   1040,
+	  1024,   1008,    993,    978,    964,    950,    936,    923,    910,    898,    886,    874,    862,    851,    840,    830,
+	   819,    809,    799,    790,    780,    771,    762,    753,    745,    736,    728,    720,    712,    705,    697,    690,
+	   683,    676,    669,    662,    655,    649,    643,    636,    630,    624,    618,    612,    607,    601,    596,    590,
+	   585,    580,    575,    570,    565,    560,    555,    551,    546,    542,    537,    533,    529,    524,    520,    516,
+	   512,    508,    504,    500,    496,    493,    489,    485,    482,    478,    475,    471,    468,    465,    462,    458,
+	   455,    452,    449,    446,    443,    440,    437,    434,    431,    428,    426,    423,    420,    417,    415,    412,
+	   410,    407,    405,    402,    400,    397,    395,    392,    390,    388,    386,    383,    381,    379,    377,    374,
+	   372,    370,    368,    366,    364,    362,    360,    358,    356,    354,    352,    350,    349,    347,    345,    343,
+	   341,    340,    338,    336,    334,    333,    331,    329,    328,    326,    324,    323,    321,    320,    318,    317,
+	   315,    314,    312,    311,    309,    308,    306,    305,    303,    302,    301,    299,    298,    297,    295,    294,
+	   293,    291,    290,    289,    287,    286,    285,    284,    282,    281,    280,    279,    278,    277,    275,    274,
+	   273,    272,    271,    270,    269,    267,    266,    265,    264,    263,    262,    261,    260,    259,    258,    257
+};
+
+const unsigned __striped gt_rsqrt[512] = {
+	 65535,   4096,   2896,   2365,   2048,   1832,   1672,   1548,   1448,   1365,   1295,   1235,   1182,   1136,   1095,   1058,
+	  1024,    993,    965,    940,    916,    894,    873,    854,    836,    819,    803,    788,    774,    761,    748,    736,
+	   724,    713,    702,    692,    683,    673,    664,    656,    648,    640,    632,    625,    617,    611,    604,    597,
+	   591,    585,    579,    574,    568,    563,    557,    552,    547,    543,    538,    533,    529,    524,    520,    516,
+	   512,    508,    504,    500,    497,    493,    490,    486,    483,    479,    476,    473,    470,    467,    464,    461,
+	   458,    455,    452,    450,    447,    444,    442,    439,    437,    434,    432,    429,    427,    425,    422,    420,
+	   418,    416,    414,    412,    410,    408,    406,    404,    402,    400,    398,    396,    394,    392,    391,    389,
+	   387,    385,    384,    382,    380,    379,    377,    375,    374,    372,    371,    369,    368,    366,    365,    363,
+	   362,    361,    359,    358,    357,    355,    354,    353,    351,    350,    349,    347,    346,    345,    344,    343,
+	   341,    340,    339,    338,    337,    336,    334,    333,    332,    331,    330,    329,    328,    327,    326,    325,
+	   324,    323,    322,    321,    320,    319,    318,    317,    316,    315,    314,    313,    312,    311,    311,    310,
+	   309,    308,    307,    306,    305,    304,    304,    303,    302,    301,    300,    300,    299,    298,    297,    296,
+	   296,    295,    294,    293,    293,    292,    291,    290,    290,    289,    288,    287,    287,    286,    285,    285,
+	   284,    283,    283,    282,    281,    281,    280,    279,    279,    278,    277,    277,    276,    276,    275,    274,
+	   274,    273,    272,    272,    271,    271,    270,    269,    269,    268,    268,    267,    267,    266,    266,    265,
+	   264,    264,    263,    263,    262,    262,    261,    261,    260,    260,    259,    259,    258,    258,    257,    257,
+	   256,    256,    255,    255,    254,    254,    253,    253,    252,    252,    251,    251,    250,    250,    249,    249,
+	   248,    248,    247,    247,    247,    246,    246,    245,    245,    244,    244,    243,    243,    243,    242,    242,
+	   241,    241,    241,    240,    240,    239,    239,    238,    238,    238,    237,    237,    236,    236,    236,    235,
+	   235,    235,    234,    234,    233,    233,    233,    232,    232,    232,    231,    231,    230,    230,    230,    229,
+	   229,    229,    228,    228,    228,    227,    227,    227,    226,    226,    225,    225,    225,    224,    224,    224,
+	   223,    223,    223,    222,    222,    222,    221,    221,    221,    221,    220,    220,    220,    219,    219,    219,
+	   218,    218,    218,    217,    217,    217,    216,    216,    216,    216,    215,    215,    215,    214,    214,    214,
+	   214,    213,    213,    213,    212,    212,    212,    212,    211,    211,    211,    210,    210,    210,    210,    209,
+	   209,    209,    208,    208,    208,    208,    207,    207,    207,    207,    206,    206,    206,    206,    205,    205,
+	   205,    205,    204,    204,    204,    204,    203,    203,    203,    203,    202,    202,    202,    202,    201,    201,
+	   201,    201,    200,    200,    200,    200,    199,    199,    199,    199,    198,    198,    198,    198,    198,    197,
+	   197,    197,    197,    196,    196,    196,    196,    195,    195,    195,    195,    195,    194,    194,    194,    194,
+	   194,    193,    193,    193,    193,    192,    192,    192,    192,    192,    191,    191,    191,    191,    191,    190,
+	   190,    190,    190,    190,    189,    189,    189,    189,    189,    188,    188,    188,    188,    188,    187,    187,
+	   187,    187,    187,    186,    186,    186,    186,    186,    185,    185,    185,    185,    185,    184,    184,    184,
+	   184,    184,    184,    183,    183,    183,    183,    183,    182,    182,    182,    182,    182,    182,    181,    181
+};
+
+const unsigned __striped gt_sqr[256] = {
+	     0,      1,      4,      9,     16,     25,     36,     49,     64,     81,    100,    121,    144,    169,    196,    225,
+	   256,    289,    324,    361,    400,    441,    484,    529,    576,    625,    676,    729,    784,    841,    900,    961,
+	  1024,   1089,   1156,   1225,   1296,   1369,   1444,   1521,   1600,   1681,   1764,   1849,   1936,   2025,   2116,   2209,
+	  2304,   2401,   2500,   2601,   2704,   2809,   2916,   3025,   3136,   3249,   3364,   3481,   3600,   3721,   3844,   3969,
+	  4096,   4225,   4356,   4489,   4624,   4761,   4900,   5041,   5184,   5329,   5476,   5625,   5776,   5929,   6084,   6241,
+	  6400,   6561,   6724,   6889,   7056,   7225,   7396,   7569,   7744,   7921,   8100,   8281,   8464,   8649,   8836,   9025,
+	  9216,   9409,   9604,   9801,  10000,  10201,  10404,  10609,  10816,  11025,  11236,  11449,  11664,  11881,  12100,  12321,
+	 12544,  12769,  12996,  13225,  13456,  13689,  13924,  14161,  14400,  14641,  14884,  15129,  15376,  15625,  15876,  16129,
+	 16384,  16641,  16900,  17161,  17424,  17689,  17956,  18225,  18496,  18769,  19044,  19321,  19600,  19881,  20164,  20449,
+	 20736,  21025,  21316,  21609,  21904,  22201,  22500,  22801,  23104,  23409,  23716,  24025,  24336,  24649,  24964,  25281,
+	 25600,  25921,  26244,  26569,  26896,  27225,  27556,  27889,  28224,  28561,  28900,  29241,  29584,  29929,  30276,  30625,
+	 30976,  31329,  31684,  32041,  32400,  32761,  33124,  33489,  33856,  34225,  34596,  34969,  35344,  35721,  36100,  36481,
+	 36864,  37249,  37636,  38025,  38416,  38809,  39204,  39601,  40000,  40401,  40804,  41209,  41616,  42025,  42436,  42849,
+	 43264,  43681,  44100,  44521,  44944,  45369,  45796,  46225,  46656,  47089,  47524,  47961,  48400,  48841,  49284,  49729,
+	 50176,  50625,  51076,  51529,  51984,  52441,  52900,  53361,  53824,  54289,  54756,  55225,  55696,  56169,  56644,  57121,
+	 57600,  58081,  58564,  59049,  59536,  60025,  60516,  61009,  61504,  62001,  62500,  63001,  63504,  64009,  64516,  65025
+};
+
+const unsigned __striped gt_qsqr[511] = {
+	     0,      0,      1,      2,      4,      6,      9,     12,     16,     20,     25,     30,     36,     42,     49,     56,
+	    64,     72,     81,     90,    100,    110,    121,    132,    144,    156,    169,    182,    196,    210,    225,    240,
+	   256,    272,    289,    306,    324,    342,    361,    380,    400,    420,    441,    462,    484,    506,    529,    552,
+	   576,    600,    625,    650,    676,    702,    729,    756,    784,    812,    841,    870,    900,    930,    961,    992,
+	  1024,   1056,   1089,   1122,   1156,   1190,   1225,   1260,   1296,   1332,   1369,   1406,   1444,   1482,   1521,   1560,
+	  1600,   1640,   1681,   1722,   1764,   1806,   1849,   1892,   1936,   1980,   2025,   2070,   2116,   2162,   2209,   2256,
+	  2304,   2352,   2401,   2450,   2500,   2550,   2601,   2652,   2704,   2756,   2809,   2862,   2916,   2970,   3025,   3080,
+	  3136,   3192,   3249,   3306,   3364,   3422,   3481,   3540,   3600,   3660,   3721,   3782,   3844,   3906,   3969,   4032,
+	  4096,   4160,   4225,   4290,   4356,   4422,   4489,   4556,   4624,   4692,   4761,   4830,   4900,   4970,   5041,   5112,
+	  5184,   5256,   5329,   5402,   5476,   5550,   5625,   5700,   5776,   5852,   5929,   6006,   6084,   6162,   6241,   6320,
+	  6400,   6480,   6561,   6642,   6724,   6806,   6889,   6972,   7056,   7140,   7225,   7310,   7396,   7482,   7569,   7656,
+	  7744,   7832,   7921,   8010,   8100,   8190,   8281,   8372,   8464,   8556,   8649,   8742,   8836,   8930,   9025,   9120,
+	  9216,   9312,   9409,   9506,   9604,   9702,   9801,   9900,  10000,  10100,  10201,  10302,  10404,  10506,  10609,  10712,
+	 10816,  10920,  11025,  11130,  11236,  11342,  11449,  11556,  11664,  11772,  11881,  11990,  12100,  12210,  12321,  12432,
+	 12544,  12656,  12769,  12882,  12996,  13110,  13225,  13340,  13456,  13572,  13689,  13806,  13924,  14042,  14161,  14280,
+	 14400,  14520,  14641,  14762,  14884,  15006,  15129,  15252,  15376,  15500,  15625,  15750,  15876,  16002,  16129,  16256,
+	 16384,  16512,  16641,  16770,  16900,  17030,  17161,  17292,  17424,  17556,  17689,  17822,  17956,  18090,  18225,  18360,
+	 18496,  18632,  18769,  18906,  19044,  19182,  19321,  19460,  19600,  19740,  19881,  20022,  20164,  20306,  20449,  20592,
+	 20736,  20880,  21025,  21170,  21316,  21462,  21609,  21756,  21904,  22052,  22201,  22350,  22500,  22650,  22801,  22952,
+	 23104,  23256,  23409,  23562,  23716,  23870,  24025,  24180,  24336,  24492,  24649,  24806,  24964,  25122,  25281,  25440,
+	 25600,  25760,  25921,  26082,  26244,  26406,  26569,  26732,  26896,  27060,  27225,  27390,  27556,  27722,  27889,  28056,
+	 28224,  28392,  28561,  28730,  28900,  29070,  29241,  29412,  29584,  29756,  29929,  30102,  30276,  30450,  30625,  30800,
+	 30976,  31152,  31329,  31506,  31684,  31862,  32041,  32220,  32400,  32580,  32761,  32942,  33124,  33306,  33489,  33672,
+	 33856,  34040,  34225,  34410,  34596,  34782,  34969,  35156,  35344,  35532,  35721,  35910,  36100,  36290,  36481,  36672,
+	 36864,  37056,  37249,  37442,  37636,  37830,  38025,  38220,  38416,  38612,  38809,  39006,  39204,  39402,  39601,  39800,
+	 40000,  40200,  40401,  40602,  40804,  41006,  41209,  41412,  41616,  41820,  42025,  42230,  42436,  42642,  42849,  43056,
+	 43264,  43472,  43681,  43890,  44100,  44310,  44521,  44732,  44944,  45156,  45369,  45582,  45796,  46010,  46225,  46440,
+	 46656,  46872,  47089,  47306,  47524,  47742,  47961,  48180,  48400,  48620,  48841,  49062,  49284,  49506,  49729,  49952,
+	 50176,  50400,  50625,  50850,  51076,  51302,  51529,  51756,  51984,  52212,  52441,  52670,  52900,  53130,  53361,  53592,
+	 53824,  54056,  54289,  54522,  54756,  54990,  55225,  55460,  55696,  55932,  56169,  56406,  56644,  56882,  57121,  57360,
+	 57600,  57840,  58081,  58322,  58564,  58806,  59049,  59292,  59536,  59780,  60025,  60270,  60516,  60762,  61009,  61256,
+	 61504,  61752,  62001,  62250,  62500,  62750,  63001,  63252,  63504,  63756,  64009,  64262,  64516,  64770,  65025
+};
@@ -0,0 +1,29 @@
+#ifndef GT_TABLES_H
+#define GT_TABLES_H
+
+// Shared lookup tables — GENERATED by tools/gttab from gt_tables.def.
+// Edit the definitions and rebuild instead of changing this file.
+
+#include "gt.h"
+
+// gt_sin40[i] = round(40 * sin(i * 2*PI / 256))
+extern const signed char gt_sin40[256];
+
+// gt_cordic_atan[i] = atan(2^-i) in 16-bit angle units (32768 = PI)
+extern const int __striped gt_cordic_atan[16];
+
+// gt_recip[i] = round(65535 / i), saturated
+extern const unsigned __striped gt_recip[256];
+
+// gt_rsqrt[i] = round(4096 / sqrt(i)), saturated
+extern const unsigned __striped gt_rsqrt[512];
+
+// gt_sqr[i] = i * i
+extern const unsigned __striped gt_sqr[256];
+
+// gt_qsqr[i] = i * i / 4 (quarter squares)
+extern const unsigned __striped gt_qsqr[511];
+
+#pragma compile("gt_tables.c")
+
+#endif
@@ -0,0 +1,185 @@
+#include "gt_tilemap.h"
+
+static const byte * tilemap_map;
+static const byte * tilemap_pixels;
+static byte tilemap_w, tilemap_h;
+static byte tilemap_bank;
+static byte tilemap_banked;
+
+// Largest scroll position
+static unsigned tilemap_max_x, tilemap_max_y;
+
+// Top-left world pixel of the view held in the ring, once it holds one
+static byte tilemap_filled;
+static unsigned tilemap_sx, tilemap_sy;
+
+// Pages whose copy of the view is out of date
+static byte tilemap_stale[2];
+
+void gt_tilemap_tiles(const byte * pixels)
+{
+	tilemap_pixels = pixels;
+	tilemap_filled = 0;
+}
+
+void gt_tilemap_init(const byte * map, byte w, byte h)
+{
+	tilemap_map = map;
+	tilemap_w = w;
+	tilemap_h = h;
+	tilemap_banked = 0;
+	tilemap_max_x = (unsigned)w * GT_TILE_SIZE - GT_SCREEN_W;
+	tilemap_max_y = (unsigned)h * GT_TILE_SIZE - GT_SCREEN_H;
+	tilemap_filled = 0;
+}
+
+void gt_tilemap_init_banked(byte bank, unsigned offset, byte w, byte h)
+{
+	gt_tilemap_init((const byte *)(GT_ROM_WINDOW + offset), w, h);
+	tilemap_bank = bank;
+	tilemap_banked = 1;
+}
+
+byte gt_tilemap_get(byte tx, byte ty)
+{
+	if (!tilemap_banked)
+		return tilemap_map[(unsigned)ty * tilemap_w + tx];
+
+	gt_rom_bank(tilemap_bank);
+	byte t = tilemap_map[(unsigned)ty * tilemap_w + tx];
+	gt_rom_bank(GT_ROM_BANK_DEFAULT);
+	return t;
+}
+
+void gt_tilemap_invalidate(void)
+{
+	tilemap_stale[0] = tilemap_stale[1] = 1;
+}
+
+// Write the world pixels [x0, x0 + w) x [y0, y0 + h) into the ring, one
+// tile at a time. A band of at most 8 rows within one tile row never
+// crosses the ring's bottom edge, and a tile never crosses its right edge,
+// since 128 is a multiple of the tile size.
+static void tilemap_ring(unsigned x0, unsigned y0, byte w, byte h)
+{
+	if (!w || !h)
+		return;
+
+	gt_sprite_map(GT_BG_GX, GT_BG_GY);
+
+	unsigned y1 = y0 + h, x1 = x0 + w;
+	for (unsigned y = y0; y < y1; )
+	{
+		byte line = (byte)y & (GT_TILE_SIZE - 1);
+		byte rows = GT_TILE_SIZE - line;
+		if (rows > y1 - y)
+			rows = (byte)(y1 - y);
+
+		const byte * mrow = tilemap_map + (y >> 3) * tilemap_w;
+		byte * ring = (byte *)gtvram + ((unsigned)((byte)y & (GT_SCREEN_H - 1)) << 7);
+
+		for (unsigned x = x0; x < x1; )
+		{
+			byte col = (byte)x & (GT_TILE_SIZE - 1);
+			byte cols = GT_TILE_SIZE - col;
+			if (cols > x1 - x)
+				cols = (byte)(x1 - x);
+
+			const byte * src = tilemap_pixels + (unsigned)mrow[x >> 3] * (GT_TILE_SIZE * GT_TILE_SIZE) +
+			                   line * GT_TILE_SIZE + col;
+			byte * dst = ring + ((byte)x & (GT_SCREEN_W - 1));
+			for (byte j = 0; j < rows; j++)
+			{
+				for (byte i = 0; i < cols; i++)
+					dst[i] = src[i];
+				src += GT_TILE_SIZE;
+				dst += GT_SCREEN_W;
+			}
+
+			x += cols;
+		}
+
+		y += rows;
+	}
+}
+
+void gt_tilemap_set(byte tx, byte ty, byte tile)
+{
+	if (tilemap_banked)
+		return;
+
+	byte * p = (byte *)tilemap_map + (unsigned)ty * tilemap_w + tx;
+	if (*p == tile)
+		return;
+	*p = tile;
+
+	if (!tilemap_filled)
+		return;
+
+	// Rewrite the part of the tile inside the view held in the ring
+	unsigned px = (unsigned)tx * GT_TILE_SIZE, py = (unsigned)ty * GT_TILE_SIZE;
+	unsigned x0 = px > tilemap_sx ? px : tilemap_sx;
+	unsigned y0 = py > tilemap_sy ? py : tilemap_sy;
+	unsigned x1 = px + GT_TILE_SIZE, y1 = py + GT_TILE_SIZE;
+	if (x1 > tilemap_sx + GT_SCREEN_W)
+		x1 = tilemap_sx + GT_SCREEN_W;
+	if (y1 > tilemap_sy + GT_SCREEN_H)
+		y1 = tilemap_sy + GT_SCREEN_H;
+
+	if (x0 < x1 && y0 < y1)
+	{
+		tilemap_ring(x0, y0, (byte)(x1 - x0), (byte)(y1 - y0));
+		gt_tilemap_invalidate();
+	}
+}
+
+void gt_tilemap_draw(unsigned sx, unsigned sy)
+{
+	if (sx > tilemap_max_x)
+		sx = tilemap_max_x;
+	if (sy > tilemap_max_y)
+		sy = tilemap_max_y;
+
+	if (!tilemap_filled || sx != tilemap_sx || sy != tilemap_sy)
+	{
+		if (tilemap_banked)
+			gt_rom_bank(tilemap_bank);
+
+		if (!tilemap_filled ||
+		    sx + GT_SCREEN_W <= tilemap_sx || sx >= tilemap_sx + GT_SCREEN_W ||
+		    sy + GT_SCREEN_H <= tilemap_sy || sy >= tilemap_sy + GT_SCREEN_H)
+		{
+			tilemap_ring(sx, sy, GT_SCREEN_W, GT_SCREEN_H);
+			tilemap_filled = 1;
+		}
+		else
+		{
+			// Columns uncovered at the old rows, then rows uncovered at
+			// the new columns; whatever the first pass writes outside the
+			// new view lands where the second pass overwrites it
+			if (sx > tilemap_sx)
+				tilemap_ring(tilemap_sx + GT_SCREEN_W, tilemap_sy, (byte)(sx - tilemap_sx), GT_SCREEN_H);
+			else if (sx < tilemap_sx)
+				tilemap_ring(sx, tilemap_sy, (byte)(tilemap_sx - sx), GT_SCREEN_H);
+
+			if (sy > tilemap_sy)
+				tilemap_ring(sx, tilemap_sy + GT_SCREEN_H, GT_SCREEN_W, (byte)(sy - tilemap_sy));
+			else if (sy < tilemap_sy)
+				tilemap_ring(sx, sy, GT_SCREEN_W, (byte)(tilemap_sy - sy));
+		}
+
+		if (tilemap_banked)
+			gt_rom_bank(GT_ROM_BANK_DEFAULT);
+
+		tilemap_sx = sx;
+		tilemap_sy = sy;
+		gt_tilemap_invalidate();
+	}
+
+	byte page = gt_draw_page();
+	if (tilemap_stale[page])
+	{
+		gt_bg_restore_wrap((byte)sx, (byte)sy);
+		tilemap_stale[page] = 0;
+	}
+}
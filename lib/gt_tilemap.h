@@ -0,0 +1,65 @@
+#ifndef GT_TILEMAP_H
+#define GT_TILEMAP_H
+
+// Tile Map
+// Draws a map of 8x8 tiles larger than the screen, scrolled to any pixel
+// position. The map is one byte per tile, row by row, in RAM or in a ROM
+// bank; the tiles are 64 VRAM values each.
+//
+// The view is kept in the background layer of gt_bg.h, used as a ring: the
+// world pixel (x, y) on screen always sits at (x mod 128, y mod 128) in the
+// layer, and gt_bg_restore_wrap() copies it to the screen in four blits.
+// A scroll writes only the pixel columns and rows it uncovers into the
+// layer, with the CPU; tiles changed with gt_tilemap_set() are written
+// there at once. A page is copied only when the view moved or changed
+// since that page was last drawn, so a still view costs nothing.
+//
+// Writing the layer costs roughly 40 cycles per piece of a tile, 20 per
+// pixel row of it and 12 per pixel: a one pixel scroll is about 5000
+// cycles across and 2500 down, a tenth and a twentieth of a frame. Filling
+// the whole view, on the first draw or after a jump of a screen or more,
+// takes about four frames.
+//
+// Setup:
+//     gt_tilemap_tiles(tile_pixels);          // 64 bytes per tile
+//     gt_tilemap_init(map, 32, 32);
+//
+// Typical frame:
+//     gt_tilemap_draw(sx, sy);                // instead of gt_clear()
+//     gt_sync();
+
+#include "gt.h"
+#include "gt_bg.h"
+
+#define GT_TILE_SIZE  8
+
+// Pixels of every tile the map uses, 64 VRAM values per tile in tile
+// number order, row by row (0 is drawn as is). They are read whenever the
+// layer is written, so they stay in RAM or in the fixed program bank at
+// $C000 and up, never in the $8000 window.
+void gt_tilemap_tiles(const byte * pixels);
+
+// Use a w x h map (at least 16 x 16) in RAM or in the fixed program bank
+void gt_tilemap_init(const byte * map, byte w, byte h);
+
+// Use a w x h map stored at offset in a ROM bank; it must not cross into
+// the next bank. The bank is mapped while gt_tilemap_draw() reads it.
+void gt_tilemap_init_banked(byte bank, unsigned offset, byte w, byte h);
+
+// Tile at (tx, ty) of the map
+byte gt_tilemap_get(byte tx, byte ty);
+
+// Change a tile of a RAM map; both pages show it at their next draw
+void gt_tilemap_set(byte tx, byte ty, byte tile);
+
+// Show the view whose top-left corner is world pixel (sx, sy), clamped to
+// the map, in the draw page
+void gt_tilemap_draw(unsigned sx, unsigned sy);
+
+// Make the next draw of each page copy the view again, after something
+// else was drawn over the map or the background layer was used otherwise
+void gt_tilemap_invalidate(void);
+
+#pragma compile("gt_tilemap.c")
+
+#endif
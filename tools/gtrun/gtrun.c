@@ -0,0 +1,1313 @@
+// gtrun — Headless cycle-counting GameTank runner
+//
+// Loads a 2MB .gtr ROM image, runs it without a display for a number of
+// frames and reports what each frame cost: CPU cycles spent executing,
+// cycles halted in WAI, blits started and pixels filled, and the cycles
+// the audio coprocessor ran. Output is CSV or JSON on stdout, with a
+// one-line summary on stderr.
+//
+// The model covers what lib/gt.h describes: a 65C02 core, the system
+// registers at $2000 (banking, dma_flags, gamepads), the VIA at $2800
+// (T1/T2 timers and the SPI ROM bank shift register), the blitter at
+// $4000 with both framebuffer pages and sprite RAM, and the vblank NMI.
+// The blitter fills one pixel per CPU cycle and raises a level-triggered
+// IRQ on completion that stays asserted until $4006 is written.
+// A second 65C02 core stands in for the audio coprocessor: it runs from
+// audio RAM in lockstep with the main CPU while bit 7 of audio_rate is
+// set, and $2000 / $2001 reset it and send it an NMI. Its DAC and sample
+// rate interrupt are not modelled.
+//
+// Build (host compiler, not oscar64):
+//     cc -O2 -o tools/gtrun/gtrun tools/gtrun/gtrun.c
+//
+// Example:
+//     tools/gtrun/gtrun -n 120 -s 4 1330_CollidingBoxes/collidingboxes.gtr
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <getopt.h>
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+// ---------------------------------------------------------------------------
+// Hardware Constants (mirrors lib/gt.h)
+// ---------------------------------------------------------------------------
+#define ROM_SIZE        (2 * 1024 * 1024)
+#define ROM_BANK_SIZE   0x4000
+#define ROM_BANKS       (ROM_SIZE / ROM_BANK_SIZE)
+
+#define RAM_SIZE        0x2000
+#define ARAM_SIZE       0x1000
+#define PAGE_SIZE       (128 * 128)
+#define GRAM_BANKS      8
+#define GRAM_BANK_SIZE  (256 * 256)
+
+#define BANK_VRAM_SELECT  0x08
+#define BANK_CLIP_X       0x10
+#define BANK_CLIP_Y       0x20
+
+#define DMA_ENABLE         0x01
+#define DMA_PAGE_OUT       0x02
+#define DMA_NMI            0x04
+#define DMA_COLORFILL      0x08
+#define DMA_GCARRY         0x10
+#define DMA_CPU_TO_VRAM    0x20
+#define DMA_IRQ            0x40
+#define DMA_OPAQUE         0x80
+
+#define AUDIO_RUN     0x80
+
+#define VIA_SPI_CLK   0x01
+#define VIA_SPI_MOSI  0x02
+#define VIA_SPI_CS    0x04
+
+#define DEFAULT_CLOCK   3579545
+#define FRAME_RATE      60
+
+// ---------------------------------------------------------------------------
+// 65C02 Core
+// ---------------------------------------------------------------------------
+#define FLAG_C  0x01
+#define FLAG_Z  0x02
+#define FLAG_I  0x04
+#define FLAG_D  0x08
+#define FLAG_B  0x10
+#define FLAG_U  0x20
+#define FLAG_V  0x40
+#define FLAG_N  0x80
+
+struct CPU
+{
+	u16  pc;
+	u8   a, x, y, s, p;
+	int  waiting;           // Halted by WAI
+	int  stopped;           // Halted by STP
+	int  nmi_pending;       // Edge latched, taken before the next opcode
+	int  irq_line;          // Level, sampled before each opcode
+	u32  irqs, nmis;        // Interrupts taken
+	u8   (*read)(void *ctx, u16 addr);
+	void (*write)(void *ctx, u16 addr, u8 value);
+	void *ctx;
+};
+
+static inline u8 rd(struct CPU *c, u16 a)
+{
+	return c->read(c->ctx, a);
+}
+
+static inline void wr(struct CPU *c, u16 a, u8 v)
+{
+	c->write(c->ctx, a, v);
+}
+
+static inline u16 rd16(struct CPU *c, u16 a)
+{
+	return rd(c, a) | (rd(c, (u16)(a + 1)) << 8);
+}
+
+static inline u16 rd16zp(struct CPU *c, u8 a)
+{
+	return rd(c, a) | (rd(c, (u8)(a + 1)) << 8);
+}
+
+static inline void push(struct CPU *c, u8 v)
+{
+	wr(c, 0x100 | c->s, v);
+	c->s--;
+}
+
+static inline u8 pull(struct CPU *c)
+{
+	c->s++;
+	return rd(c, 0x100 | c->s);
+}
+
+static inline void setnz(struct CPU *c, u8 v)
+{
+	c->p = (c->p & ~(FLAG_N | FLAG_Z)) | (v & FLAG_N) | (v ? 0 : FLAG_Z);
+}
+
+static void cpu_reset(struct CPU *c)
+{
+	c->a = c->x = c->y = 0;
+	c->s = 0xFD;
+	c->p = FLAG_U | FLAG_I;
+	c->waiting = c->stopped = 0;
+	c->nmi_pending = 0;
+	c->irq_line = 0;
+	c->pc = rd16(c, 0xFFFC);
+}
+
+static void cpu_interrupt(struct CPU *c, u16 vector, int brk)
+{
+	push(c, c->pc >> 8);
+	push(c, c->pc & 0xFF);
+	push(c, (u8)((c->p | FLAG_U | FLAG_B) & (brk ? 0xFF : ~FLAG_B)));
+	c->p = (c->p | FLAG_I) & ~FLAG_D;
+	c->pc = rd16(c, vector);
+}
+
+static void op_adc(struct CPU *c, u8 v, int *cyc)
+{
+	unsigned carry = c->p & FLAG_C;
+	if (c->p & FLAG_D)
+	{
+		unsigned lo = (c->a & 0x0F) + (v & 0x0F) + carry;
+		if (lo > 9) lo += 6;
+		unsigned hi = (c->a >> 4) + (v >> 4) + (lo > 0x0F);
+		int ov = (~(c->a ^ v) & (c->a ^ (hi << 4)) & 0x80) != 0;
+		if (hi > 9) hi += 6;
+		c->p &= ~(FLAG_C | FLAG_V);
+		if (hi > 0x0F) c->p |= FLAG_C;
+		if (ov) c->p |= FLAG_V;
+		c->a = (u8)((hi << 4) | (lo & 0x0F));
+		setnz(c, c->a);
+		(*cyc)++;
+	}
+	else
+	{
+		unsigned r = c->a + v + carry;
+		c->p &= ~(FLAG_C | FLAG_V);
+		if (r > 0xFF) c->p |= FLAG_C;
+		if (~(c->a ^ v) & (c->a ^ r) & 0x80) c->p |= FLAG_V;
+		c->a = (u8)r;
+		setnz(c, c->a);
+	}
+}
+
+static void op_sbc(struct CPU *c, u8 v, int *cyc)
+{
+	if (c->p & FLAG_D)
+	{
+		int borrow = (c->p & FLAG_C) ? 0 : 1;
+		int lo = (c->a & 0x0F) - (v & 0x0F) - borrow;
+		int hi = (c->a >> 4) - (v >> 4);
+		unsigned bin = c->a - v - borrow;
+		if (lo < 0) { lo -= 6; hi--; }
+		if (hi < 0) hi -= 6;
+		c->p &= ~(FLAG_C | FLAG_V);
+		if (bin < 0x100) c->p |= FLAG_C;
+		if ((c->a ^ v) & (c->a ^ bin) & 0x80) c->p |= FLAG_V;
+		c->a = (u8)(((hi << 4) & 0xF0) | (lo & 0x0F));
+		setnz(c, c->a);
+		(*cyc)++;
+	}
+	else
+		op_adc(c, (u8)~v, cyc);
+}
+
+static void op_cmp(struct CPU *c, u8 r, u8 v)
+{
+	unsigned d = r - v;
+	c->p &= ~FLAG_C;
+	if (r >= v) c->p |= FLAG_C;
+	setnz(c, (u8)d);
+}
+
+static u8 op_rmw(struct CPU *c, u8 op, u8 v)
+{
+	unsigned carry = c->p & FLAG_C;
+	switch (op & 0xE0)
+	{
+	case 0x00:  // ASL
+		c->p = (c->p & ~FLAG_C) | (v >> 7);
+		v <<= 1;
+		break;
+	case 0x20:  // ROL
+		c->p = (c->p & ~FLAG_C) | (v >> 7);
+		v = (u8)((v << 1) | carry);
+		break;
+	case 0x40:  // LSR
+		c->p = (c->p & ~FLAG_C) | (v & 1);
+		v >>= 1;
+		break;
+	case 0x60:  // ROR
+		c->p = (c->p & ~FLAG_C) | (v & 1);
+		v = (u8)((v >> 1) | (carry << 7));
+		break;
+	case 0xC0:  // DEC
+		v--;
+		break;
+	case 0xE0:  // INC
+		v++;
+		break;
+	}
+	setnz(c, v);
+	return v;
+}
+
+// Operand address for the addressing mode encoded in opcode bits 2-4 of
+// the regular ALU group (cc = 01). *cross is set on an indexed page cross.
+static u16 ea_group1(struct CPU *c, u8 op, int *cross)
+{
+	u16 base, ea;
+	u8 zp;
+
+	switch ((op >> 2) & 7)
+	{
+	case 0:     // (zp,X)
+		zp = rd(c, c->pc++);
+		return rd16zp(c, (u8)(zp + c->x));
+	case 1:     // zp
+		return rd(c, c->pc++);
+	case 2:     // #imm
+		return c->pc++;
+	case 3:     // abs
+		ea = rd16(c, c->pc);
+		c->pc += 2;
+		return ea;
+	case 4:     // (zp),Y
+		base = rd16zp(c, rd(c, c->pc++));
+		ea = base + c->y;
+		*cross = (base ^ ea) >> 8 != 0;
+		return ea;
+	case 5:     // zp,X
+		return (u8)(rd(c, c->pc++) + c->x);
+	case 6:     // abs,Y
+		base = rd16(c, c->pc);
+		c->pc += 2;
+		ea = base + c->y;
+		*cross = (base ^ ea) >> 8 != 0;
+		return ea;
+	default:    // abs,X
+		base = rd16(c, c->pc);
+		c->pc += 2;
+		ea = base + c->x;
+		*cross = (base ^ ea) >> 8 != 0;
+		return ea;
+	}
+}
+
+static const u8 group1_cycles[8] = {6, 3, 2, 4, 5, 4, 4, 4};
+
+static int branch(struct CPU *c, int cond)
+{
+	signed char off = (signed char)rd(c, c->pc++);
+	if (!cond)
+		return 2;
+	u16 target = c->pc + off;
+	int cyc = 3 + ((target ^ c->pc) >> 8 != 0);
+	c->pc = target;
+	return cyc;
+}
+
+// Execute one instruction (or take a pending interrupt) and return the
+// number of cycles it took. Returns 0 while halted by WAI or STP.
+static int cpu_step(struct CPU *c)
+{
+	if (c->stopped)
+		return 0;
+
+	if (c->nmi_pending)
+	{
+		c->nmi_pending = 0;
+		c->waiting = 0;
+		c->nmis++;
+		cpu_interrupt(c, 0xFFFA, 0);
+		return 7;
+	}
+
+	if (c->irq_line)
+	{
+		// WAI wakes on IRQ even when interrupts are masked
+		c->waiting = 0;
+		if (!(c->p & FLAG_I))
+		{
+			c->irqs++;
+			cpu_interrupt(c, 0xFFFE, 0);
+			return 7;
+		}
+	}
+
+	if (c->waiting)
+		return 0;
+
+	u8 op = rd(c, c->pc++);
+	int cyc = 0, cross = 0;
+	u16 ea;
+	u8 v;
+
+	// Regular ALU group: ORA AND EOR ADC STA LDA CMP SBC
+	if ((op & 3) == 1)
+	{
+		ea = ea_group1(c, op, &cross);
+		cyc = group1_cycles[(op >> 2) & 7];
+		if ((op & 0xE0) == 0x80)
+		{
+			if (op == 0x89)     // BIT #imm (65C02)
+			{
+				v = rd(c, ea);
+				c->p = (c->p & ~FLAG_Z) | ((c->a & v) ? 0 : FLAG_Z);
+				return 2;
+			}
+			wr(c, ea, c->a);
+			if (((op >> 2) & 7) >= 4 && ((op >> 2) & 7) != 5)
+				cyc++;      // Indexed stores always take the extra cycle
+			return cyc;
+		}
+		v = rd(c, ea);
+		cyc += cross;
+		switch (op & 0xE0)
+		{
+		case 0x00: c->a |= v;  setnz(c, c->a); break;
+		case 0x20: c->a &= v;  setnz(c, c->a); break;
+		case 0x40: c->a ^= v;  setnz(c, c->a); break;
+		case 0x60: op_adc(c, v, &cyc); break;
+		case 0xA0: c->a = v;   setnz(c, c->a); break;
+		case 0xC0: op_cmp(c, c->a, v); break;
+		case 0xE0: op_sbc(c, v, &cyc); break;
+		}
+		return cyc;
+	}
+
+	// (zp) addressing for the ALU group (65C02): opcodes x2 with x odd
+	if ((op & 0x1F) == 0x12)
+	{
+		ea = rd16zp(c, rd(c, c->pc++));
+		cyc = 5;
+		switch (op & 0xE0)
+		{
+		case 0x00: c->a |= rd(c, ea); setnz(c, c->a); break;
+		case 0x20: c->a &= rd(c, ea); setnz(c, c->a); break;
+		case 0x40: c->a ^= rd(c, ea); setnz(c, c->a); break;
+		case 0x60: op_adc(c, rd(c, ea), &cyc); break;
+		case 0x80: wr(c, ea, c->a); break;
+		case 0xA0: c->a = rd(c, ea); setnz(c, c->a); break;
+		case 0xC0: op_cmp(c, c->a, rd(c, ea)); break;
+		case 0xE0: op_sbc(c, rd(c, ea), &cyc); break;
+		}
+		return cyc;
+	}
+
+	// RMB/SMB/BBR/BBS (WDC)
+	if ((op & 0x0F) == 0x07)
+	{
+		u8 zp = rd(c, c->pc++);
+		u8 bit = 1 << ((op >> 4) & 7);
+		v = rd(c, zp);
+		wr(c, zp, (op & 0x80) ? (v | bit) : (v & ~bit));
+		return 5;
+	}
+	if ((op & 0x0F) == 0x0F)
+	{
+		u8 zp = rd(c, c->pc++);
+		u8 bit = 1 << ((op >> 4) & 7);
+		v = rd(c, zp);
+		int set = (v & bit) != 0;
+		return 3 + branch(c, (op & 0x80) ? set : !set);
+	}
+
+	switch (op)
+	{
+	// Branches
+	case 0x10: return branch(c, !(c->p & FLAG_N));
+	case 0x30: return branch(c, c->p & FLAG_N);
+	case 0x50: return branch(c, !(c->p & FLAG_V));
+	case 0x70: return branch(c, c->p & FLAG_V);
+	case 0x90: return branch(c, !(c->p & FLAG_C));
+	case 0xB0: return branch(c, c->p & FLAG_C);
+	case 0xD0: return branch(c, !(c->p & FLAG_Z));
+	case 0xF0: return branch(c, c->p & FLAG_Z);
+	case 0x80: return branch(c, 1);
+
+	// Shifts and INC/DEC
+	case 0x0A: case 0x2A: case 0x4A: case 0x6A:
+		c->a = op_rmw(c, op, c->a);
+		return 2;
+	case 0x1A: c->a++; setnz(c, c->a); return 2;
+	case 0x3A: c->a--; setnz(c, c->a); return 2;
+	case 0x06: case 0x26: case 0x46: case 0x66: case 0xC6: case 0xE6:
+		ea = rd(c, c->pc++);
+		wr(c, ea, op_rmw(c, op, rd(c, ea)));
+		return 5;
+	case 0x16: case 0x36: case 0x56: case 0x76: case 0xD6: case 0xF6:
+		ea = (u8)(rd(c, c->pc++) + c->x);
+		wr(c, ea, op_rmw(c, op, rd(c, ea)));
+		return 6;
+	case 0x0E: case 0x2E: case 0x4E: case 0x6E: case 0xCE: case 0xEE:
+		ea = rd16(c, c->pc);
+		c->pc += 2;
+		wr(c, ea, op_rmw(c, op, rd(c, ea)));
+		return 6;
+	case 0x1E: case 0x3E: case 0x5E: case 0x7E: case 0xDE: case 0xFE:
+	{
+		u16 base = rd16(c, c->pc);
+		c->pc += 2;
+		ea = base + c->x;
+		wr(c, ea, op_rmw(c, op, rd(c, ea)));
+		if (op >= 0xDE)
+			return 7;
+		return 6 + ((base ^ ea) >> 8 != 0);
+	}
+
+	// Loads and stores of X/Y and STZ
+	case 0xA2: c->x = rd(c, c->pc++); setnz(c, c->x); return 2;
+	case 0xA6: c->x = rd(c, rd(c, c->pc++)); setnz(c, c->x); return 3;
+	case 0xB6: c->x = rd(c, (u8)(rd(c, c->pc++) + c->y)); setnz(c, c->x); return 4;
+	case 0xAE: c->x = rd(c, rd16(c, c->pc)); c->pc += 2; setnz(c, c->x); return 4;
+	case 0xBE:
+	{
+		u16 base = rd16(c, c->pc);
+		c->pc += 2;
+		ea = base + c->y;
+		c->x = rd(c, ea);
+		setnz(c, c->x);
+		return 4 + ((base ^ ea) >> 8 != 0);
+	}
+	case 0xA0: c->y = rd(c, c->pc++); setnz(c, c->y); return 2;
+	case 0xA4: c->y = rd(c, rd(c, c->pc++)); setnz(c, c->y); return 3;
+	case 0xB4: c->y = rd(c, (u8)(rd(c, c->pc++) + c->x)); setnz(c, c->y); return 4;
+	case 0xAC: c->y = rd(c, rd16(c, c->pc)); c->pc += 2; setnz(c, c->y); return 4;
+	case 0xBC:
+	{
+		u16 base = rd16(c, c->pc);
+		c->pc += 2;
+		ea = base + c->x;
+		c->y = rd(c, ea);
+		setnz(c, c->y);
+		return 4 + ((base ^ ea) >> 8 != 0);
+	}
+	case 0x86: wr(c, rd(c, c->pc++), c->x); return 3;
+	case 0x96: wr(c, (u8)(rd(c, c->pc++) + c->y), c->x); return 4;
+	case 0x8E: wr(c, rd16(c, c->pc), c->x); c->pc += 2; return 4;
+	case 0x84: wr(c, rd(c, c->pc++), c->y); return 3;
+	case 0x94: wr(c, (u8)(rd(c, c->pc++) + c->x), c->y); return 4;
+	case 0x8C: wr(c, rd16(c, c->pc), c->y); c->pc += 2; return 4;
+	case 0x64: wr(c, rd(c, c->pc++), 0); return 3;
+	case 0x74: wr(c, (u8)(rd(c, c->pc++) + c->x), 0); return 4;
+	case 0x9C: wr(c, rd16(c, c->pc), 0); c->pc += 2; return 4;
+	case 0x9E: wr(c, (u16)(rd16(c, c->pc) + c->x), 0); c->pc += 2; return 5;
+
+	// Compares of X/Y
+	case 0xE0: op_cmp(c, c->x, rd(c, c->pc++)); return 2;
+	case 0xE4: op_cmp(c, c->x, rd(c, rd(c, c->pc++))); return 3;
+	case 0xEC: op_cmp(c, c->x, rd(c, rd16(c, c->pc))); c->pc += 2; return 4;
+	case 0xC0: op_cmp(c, c->y, rd(c, c->pc++)); return 2;
+	case 0xC4: op_cmp(c, c->y, rd(c, rd(c, c->pc++))); return 3;
+	case 0xCC: op_cmp(c, c->y, rd(c, rd16(c, c->pc))); c->pc += 2; return 4;
+
+	// BIT, TSB, TRB
+	case 0x24: case 0x2C: case 0x34: case 0x3C:
+	{
+		if (op == 0x24)      { ea = rd(c, c->pc++); cyc = 3; }
+		else if (op == 0x34) { ea = (u8)(rd(c, c->pc++) + c->x); cyc = 4; }
+		else
+		{
+			u16 base = rd16(c, c->pc);
+			c->pc += 2;
+			ea = op == 0x3C ? (u16)(base + c->x) : base;
+			cyc = 4 + (op == 0x3C && ((base ^ ea) >> 8) != 0);
+		}
+		v = rd(c, ea);
+		c->p = (c->p & ~(FLAG_N | FLAG_V | FLAG_Z)) | (v & (FLAG_N | FLAG_V)) |
+		       ((c->a & v) ? 0 : FLAG_Z);
+		return cyc;
+	}
+	case 0x04: case 0x0C: case 0x14: case 0x1C:
+		if (op & 0x08) { ea = rd16(c, c->pc); c->pc += 2; cyc = 6; }
+		else           { ea = rd(c, c->pc++); cyc = 5; }
+		v = rd(c, ea);
+		c->p = (c->p & ~FLAG_Z) | ((c->a & v) ? 0 : FLAG_Z);
+		wr(c, ea, (op & 0x10) ? (v & ~c->a) : (v | c->a));
+		return cyc;
+
+	// Jumps and subroutines
+	case 0x4C: c->pc = rd16(c, c->pc); return 3;
+	case 0x6C: c->pc = rd16(c, rd16(c, c->pc)); return 6;
+	case 0x7C: c->pc = rd16(c, (u16)(rd16(c, c->pc) + c->x)); return 6;
+	case 0x20:
+		ea = rd16(c, c->pc);
+		c->pc++;
+		push(c, c->pc >> 8);
+		push(c, c->pc & 0xFF);
+		c->pc = ea;
+		return 6;
+	case 0x60:
+		c->pc = pull(c);
+		c->pc |= pull(c) << 8;
+		c->pc++;
+		return 6;
+	case 0x40:
+		c->p = pull(c) | FLAG_U;
+		c->pc = pull(c);
+		c->pc |= pull(c) << 8;
+		return 6;
+	case 0x00:
+		c->pc++;
+		cpu_interrupt(c, 0xFFFE, 1);
+		return 7;
+
+	// Stack
+	case 0x48: push(c, c->a); return 3;
+	case 0xDA: push(c, c->x); return 3;
+	case 0x5A: push(c, c->y); return 3;
+	case 0x08: push(c, c->p | FLAG_B | FLAG_U); return 3;
+	case 0x68: c->a = pull(c); setnz(c, c->a); return 4;
+	case 0xFA: c->x = pull(c); setnz(c, c->x); return 4;
+	case 0x7A: c->y = pull(c); setnz(c, c->y); return 4;
+	case 0x28: c->p = pull(c) | FLAG_U; return 4;
+
+	// Register transfers and increments
+	case 0xAA: c->x = c->a; setnz(c, c->x); return 2;
+	case 0x8A: c->a = c->x; setnz(c, c->a); return 2;
+	case 0xA8: c->y = c->a; setnz(c, c->y); return 2;
+	case 0x98: c->a = c->y; setnz(c, c->a); return 2;
+	case 0xBA: c->x = c->s; setnz(c, c->x); return 2;
+	case 0x9A: c->s = c->x; return 2;
+	case 0xE8: c->x++; setnz(c, c->x); return 2;
+	case 0xCA: c->x--; setnz(c, c->x); return 2;
+	case 0xC8: c->y++; setnz(c, c->y); return 2;
+	case 0x88: c->y--; setnz(c, c->y); return 2;
+
+	// Flags
+	case 0x18: c->p &= ~FLAG_C; return 2;
+	case 0x38: c->p |= FLAG_C; return 2;
+	case 0x58: c->p &= ~FLAG_I; return 2;
+	case 0x78: c->p |= FLAG_I; return 2;
+	case 0xB8: c->p &= ~FLAG_V; return 2;
+	case 0xD8: c->p &= ~FLAG_D; return 2;
+	case 0xF8: c->p |= FLAG_D; return 2;
+	case 0xEA: return 2;
+
+	// WAI / STP
+	case 0xCB: c->waiting = 1; return 3;
+	case 0xDB: c->stopped = 1; return 3;
+
+	// Undefined opcodes are NOPs of various lengths on the 65C02
+	case 0x02: case 0x22: case 0x42: case 0x62: case 0x82: case 0xC2: case 0xE2:
+		c->pc++;
+		return 2;
+	case 0x44: c->pc++; return 3;
+	case 0x54: case 0xD4: case 0xF4: c->pc++; return 4;
+	case 0x5C: c->pc += 2; return 8;
+	case 0xDC: case 0xFC: c->pc += 2; return 4;
+	default:
+		return 1;
+	}
+}
+
+// ---------------------------------------------------------------------------
+// GameTank Machine
+// ---------------------------------------------------------------------------
+
+struct Blitter
+{
+	u8   vx, vy, gx, gy, width, height, color;
+	int  busy;
+	u64  done_at;           // Cycle at which the running blit completes
+	int  irq;               // Completion IRQ, held until $4006 is written
+};
+
+struct VIA
+{
+	u8   ora, ddra, orb, ddrb;
+	u16  t1_counter, t1_latch;
+	u16  t2_counter;
+	u8   t2_latch_lo;
+	int  t1_armed, t2_armed;
+	u8   acr, pcr, ifr, ier;
+	u8   spi_shift;         // Bits clocked in over SPI
+	u8   rom_bank;          // Latched banked-ROM select
+};
+
+struct Stats
+{
+	u64  start;
+	u64  cpu;               // Cycles executing instructions
+	u64  wai;               // Cycles halted in WAI/STP
+	u64  blit_busy;         // Cycles the blitter was running
+	u64  acp;               // Cycles the audio coprocessor ran
+	u32  blits;
+	u64  pixels;
+	u32  irqs;
+	u32  nmis;
+	u32  vblanks;
+	u32  flips;
+	u32  bank_switches;
+};
+
+struct Machine
+{
+	struct CPU      cpu;
+	struct CPU      acp;                // Audio coprocessor
+	int             acp_budget;         // Cycles it is behind the main CPU
+	u8              audio_rate;
+	u8             *rom;
+	u8              ram[RAM_SIZE];
+	u8              aram[ARAM_SIZE];
+	u8              vram[2][PAGE_SIZE];
+	u8              gram[GRAM_BANKS][GRAM_BANK_SIZE];
+	u8              banking;
+	u8              dma_flags;
+	u8              gram_quadrant;      // Sprite RAM quadrant for CPU access
+	struct Blitter  blit;
+	struct VIA      via;
+	u64             cycle;
+	int             pad_phase[2];
+	u16             pad_mask[2];        // Held buttons, gt_read_gamepad() layout
+	struct Stats    frame;
+};
+
+static u8 pad_read(struct Machine *m, int port)
+{
+	// First read returns the low byte, second the high byte, active-low
+	u16 mask = m->pad_mask[port];
+	u8 v = m->pad_phase[port] ? (u8)(mask >> 8) : (u8)mask;
+	m->pad_phase[port] ^= 1;
+	return (u8)~v;
+}
+
+static u8 via_read(struct Machine *m, u8 reg)
+{
+	struct VIA *v = &m->via;
+
+	switch (reg)
+	{
+	case 0x0: return v->orb;
+	case 0x1: case 0xF: return v->ora;
+	case 0x2: return v->ddrb;
+	case 0x3: return v->ddra;
+	case 0x4: v->ifr &= ~0x40; return v->t1_counter & 0xFF;
+	case 0x5: return v->t1_counter >> 8;
+	case 0x6: return v->t1_latch & 0xFF;
+	case 0x7: return v->t1_latch >> 8;
+	case 0x8: v->ifr &= ~0x20; return v->t2_counter & 0xFF;
+	case 0x9: return v->t2_counter >> 8;
+	case 0xB: return v->acr;
+	case 0xC: return v->pcr;
+	case 0xD:
+		return (v->ifr & 0x7F) | ((v->ifr & v->ier & 0x7F) ? 0x80 : 0);
+	case 0xE: return v->ier | 0x80;
+	default:  return 0;
+	}
+}
+
+static void via_write(struct Machine *m, u8 reg, u8 val)
+{
+	struct VIA *v = &m->via;
+
+	switch (reg)
+	{
+	case 0x0: v->orb = val; break;
+	case 0x1: case 0xF:
+	{
+		// SPI bank select: shift MOSI in on CLK rising edges, latch on CS
+		u8 rise = ~v->ora & val;
+		if (rise & VIA_SPI_CLK)
+			v->spi_shift = (u8)((v->spi_shift << 1) | ((val & VIA_SPI_MOSI) ? 1 : 0));
+		if (rise & VIA_SPI_CS)
+		{
+			if (v->rom_bank != v->spi_shift)
+				m->frame.bank_switches++;
+			v->rom_bank = v->spi_shift;
+		}
+		v->ora = val;
+		break;
+	}
+	case 0x2: v->ddrb = val; break;
+	case 0x3: v->ddra = val; break;
+	case 0x4: case 0x6: v->t1_latch = (v->t1_latch & 0xFF00) | val; break;
+	case 0x5:
+		v->t1_latch = (v->t1_latch & 0x00FF) | (val << 8);
+		v->t1_counter = v->t1_latch;
+		v->t1_armed = 1;
+		v->ifr &= ~0x40;
+		break;
+	case 0x7:
+		v->t1_latch = (v->t1_latch & 0x00FF) | (val << 8);
+		v->ifr &= ~0x40;
+		break;
+	case 0x8: v->t2_latch_lo = val; break;
+	case 0x9:
+		v->t2_counter = v->t2_latch_lo | (val << 8);
+		v->t2_armed = 1;
+		v->ifr &= ~0x20;
+		break;
+	case 0xB: v->acr = val; break;
+	case 0xC: v->pcr = val; break;
+	case 0xD: v->ifr &= ~(val & 0x7F); break;
+	case 0xE:
+		if (val & 0x80) v->ier |= val & 0x7F;
+		else            v->ier &= ~(val & 0x7F);
+		break;
+	}
+}
+
+static void via_tick(struct VIA *v, u32 cycles)
+{
+	// T1: one-shot or free-running (ACR bit 6), reloading from the latch
+	u32 n = cycles;
+	while (n)
+	{
+		u32 step = n <= (u32)v->t1_counter + 1 ? n : (u32)v->t1_counter + 1;
+		n -= step;
+		if (step == (u32)v->t1_counter + 1)
+		{
+			if (v->t1_armed)
+				v->ifr |= 0x40;
+			if (v->acr & 0x40)
+				v->t1_counter = v->t1_latch;
+			else
+			{
+				v->t1_armed = 0;
+				v->t1_counter = 0xFFFF;
+			}
+		}
+		else
+			v->t1_counter -= step;
+	}
+
+	// T2: one-shot interval timer, keeps counting down after underflow
+	if (v->t2_armed && cycles > v->t2_counter)
+	{
+		v->ifr |= 0x20;
+		v->t2_armed = 0;
+	}
+	v->t2_counter -= (u16)cycles;
+}
+
+static void blit_start(struct Machine *m)
+{
+	struct Blitter *b = &m->blit;
+	int w = b->width & 0x7F, h = b->height & 0x7F;
+	int flip_x = b->width & 0x80, flip_y = b->height & 0x80;
+	u8 *dst = m->vram[(m->banking & BANK_VRAM_SELECT) ? 1 : 0];
+	u8 *src = m->gram[m->banking & 7];
+
+	for (int j = 0; j < h; j++)
+	{
+		int dy = b->vy + j;
+		if (dy >= 128 && (m->banking & BANK_CLIP_Y))
+			break;
+		for (int i = 0; i < w; i++)
+		{
+			int dx = b->vx + i;
+			if (dx >= 128 && (m->banking & BANK_CLIP_X))
+				break;
+
+			u8 pix;
+			if (m->dma_flags & DMA_COLORFILL)
+				pix = (u8)~b->color;
+			else
+			{
+				int si = flip_x ? w - 1 - i : i;
+				int sj = flip_y ? h - 1 - j : j;
+				u8 sx, sy;
+				if (m->dma_flags & DMA_GCARRY)
+				{
+					sx = (u8)(b->gx + si);
+					sy = (u8)(b->gy + sj);
+				}
+				else
+				{
+					sx = (b->gx & 0xF0) | ((b->gx + si) & 0x0F);
+					sy = (b->gy & 0xF0) | ((b->gy + sj) & 0x0F);
+				}
+				pix = src[sy * 256 + sx];
+				if (pix == 0 && !(m->dma_flags & DMA_OPAQUE))
+					continue;
+			}
+			dst[(dy & 127) * 128 + (dx & 127)] = pix;
+		}
+	}
+
+	b->busy = 1;
+	b->done_at = m->cycle + (u64)w * h + 1;
+	m->frame.blits++;
+	m->frame.pixels += (u64)w * h;
+}
+
+static u8 *vram_window(struct Machine *m, u16 addr)
+{
+	u16 off = addr & 0x3FFF;
+
+	if (m->dma_flags & DMA_CPU_TO_VRAM)
+		return &m->vram[(m->banking & BANK_VRAM_SELECT) ? 1 : 0][off];
+
+	// Sprite RAM: 128x128 window onto the quadrant selected by gx/gy bit 7
+	int qx = (m->gram_quadrant & 1) * 128, qy = (m->gram_quadrant >> 1) * 128;
+	return &m->gram[m->banking & 7][(qy + (off >> 7)) * 256 + qx + (off & 127)];
+}
+
+// Audio coprocessor bus: audio RAM mirrored through the lower half of its
+// address space, the DAC in the upper half
+static u8 acp_read(void *ctx, u16 addr)
+{
+	struct Machine *m = ctx;
+	return m->aram[addr & 0x0FFF];
+}
+
+static void acp_write(void *ctx, u16 addr, u8 val)
+{
+	struct Machine *m = ctx;
+	if (addr < 0x8000)
+		m->aram[addr & 0x0FFF] = val;
+}
+
+static u8 mem_read(void *ctx, u16 addr)
+{
+	struct Machine *m = ctx;
+
+	if (addr < 0x2000)
+		return m->ram[addr];
+	if (addr < 0x2800)
+	{
+		switch (addr & 0x0F)
+		{
+		// Reading one port resets the other port's select line
+		case 0x08:
+			m->pad_phase[1] = 0;
+			return pad_read(m, 0);
+		case 0x09:
+			m->pad_phase[0] = 0;
+			return pad_read(m, 1);
+		default:   return 0;
+		}
+	}
+	if (addr < 0x3000)
+		return via_read(m, addr & 0x0F);
+	if (addr < 0x4000)
+		return m->aram[addr & 0x0FFF];
+	if (addr < 0x8000)
+		return (m->dma_flags & DMA_ENABLE) ? 0 : *vram_window(m, addr);
+	if (addr < 0xC000)
+		return m->rom[(m->via.rom_bank & (ROM_BANKS - 1)) * ROM_BANK_SIZE + (addr & 0x3FFF)];
+	return m->rom[(ROM_BANKS - 1) * ROM_BANK_SIZE + (addr & 0x3FFF)];
+}
+
+static void mem_write(void *ctx, u16 addr, u8 val)
+{
+	struct Machine *m = ctx;
+
+	if (addr < 0x2000)
+	{
+		m->ram[addr] = val;
+		return;
+	}
+	if (addr < 0x2800)
+	{
+		switch (addr & 0x0F)
+		{
+		case 0x00:
+			cpu_reset(&m->acp);
+			m->acp_budget = 0;
+			break;
+		case 0x01:
+			m->acp.nmi_pending = 1;
+			break;
+		case 0x05:
+			m->banking = val;
+			break;
+		case 0x06:
+			m->audio_rate = val;
+			break;
+		case 0x07:
+			if ((m->dma_flags ^ val) & DMA_PAGE_OUT)
+				m->frame.flips++;
+			m->dma_flags = val;
+			break;
+		}
+		return;
+	}
+	if (addr < 0x3000)
+	{
+		via_write(m, addr & 0x0F, val);
+		return;
+	}
+	if (addr < 0x4000)
+	{
+		m->aram[addr & 0x0FFF] = val;
+		return;
+	}
+	if (addr < 0x8000)
+	{
+		if (!(m->dma_flags & DMA_ENABLE))
+		{
+			*vram_window(m, addr) = val;
+			return;
+		}
+
+		struct Blitter *b = &m->blit;
+		switch (addr & 7)
+		{
+		case 0: b->vx = val; break;
+		case 1: b->vy = val; break;
+		case 2: b->gx = val; m->gram_quadrant = (m->gram_quadrant & 2) | (val >> 7); break;
+		case 3: b->gy = val; m->gram_quadrant = (m->gram_quadrant & 1) | ((val >> 6) & 2); break;
+		case 4: b->width = val; break;
+		case 5: b->height = val; break;
+		case 6:
+			b->irq = 0;
+			if (val & 1)
+				blit_start(m);
+			break;
+		case 7: b->color = val; break;
+		}
+	}
+}
+
+// Advance the peripherals by the given number of cycles
+static void machine_tick(struct Machine *m, u32 cycles, int halted)
+{
+	if (halted)
+		m->frame.wai += cycles;
+	else
+		m->frame.cpu += cycles;
+
+	if (m->blit.busy)
+	{
+		u64 end = m->cycle + cycles;
+		u64 stop = end < m->blit.done_at ? end : m->blit.done_at;
+		m->frame.blit_busy += stop - m->cycle;
+		if (end >= m->blit.done_at)
+		{
+			m->blit.busy = 0;
+			if (m->dma_flags & DMA_IRQ)
+				m->blit.irq = 1;
+		}
+	}
+
+	// The coprocessor catches up instruction by instruction; what it
+	// overshoots is taken off its next turn
+	if (m->audio_rate & AUDIO_RUN)
+	{
+		m->acp_budget += cycles;
+		while (m->acp_budget > 0)
+		{
+			int c = cpu_step(&m->acp);
+			if (!c)
+			{
+				// Halted, and nothing here ever raises its IRQ
+				m->acp_budget = 0;
+				break;
+			}
+			m->acp_budget -= c;
+			m->frame.acp += c;
+		}
+	}
+
+	via_tick(&m->via, cycles);
+	m->cycle += cycles;
+
+	m->cpu.irq_line = m->blit.irq || (m->via.ifr & m->via.ier & 0x7F);
+}
+
+// ---------------------------------------------------------------------------
+// Reporting
+// ---------------------------------------------------------------------------
+
+enum { FMT_CSV, FMT_JSON };
+
+static void report_header(int fmt)
+{
+	if (fmt == FMT_CSV)
+		printf("frame,start,cycles,cpu,wai,blits,pixels,blit_busy,irqs,nmis,vblanks,flips,bank_switches,acp\n");
+	else
+		printf("[\n");
+}
+
+static void report_frame(int fmt, int index, const struct Stats *s, u64 end)
+{
+	u64 cycles = end - s->start;
+
+	if (fmt == FMT_CSV)
+	{
+		printf("%d,%llu,%llu,%llu,%llu,%u,%llu,%llu,%u,%u,%u,%u,%u,%llu\n",
+		       index, (unsigned long long)s->start, (unsigned long long)cycles,
+		       (unsigned long long)s->cpu, (unsigned long long)s->wai,
+		       s->blits, (unsigned long long)s->pixels,
+		       (unsigned long long)s->blit_busy, s->irqs, s->nmis,
+		       s->vblanks, s->flips, s->bank_switches, (unsigned long long)s->acp);
+	}
+	else
+	{
+		printf("%s  {\"frame\": %d, \"start\": %llu, \"cycles\": %llu, \"cpu\": %llu, "
+		       "\"wai\": %llu, \"blits\": %u, \"pixels\": %llu, \"blit_busy\": %llu, "
+		       "\"irqs\": %u, \"nmis\": %u, \"vblanks\": %u, \"flips\": %u, "
+		       "\"bank_switches\": %u, \"acp\": %llu}",
+		       index ? ",\n" : "", index, (unsigned long long)s->start,
+		       (unsigned long long)cycles, (unsigned long long)s->cpu,
+		       (unsigned long long)s->wai, s->blits, (unsigned long long)s->pixels,
+		       (unsigned long long)s->blit_busy, s->irqs, s->nmis, s->vblanks,
+		       s->flips, s->bank_switches, (unsigned long long)s->acp);
+	}
+}
+
+static void report_footer(int fmt)
+{
+	if (fmt == FMT_JSON)
+		printf("\n]\n");
+}
+
+static int dump_page(struct Machine *m, const char *path)
+{
+	FILE *f = fopen(path, "wb");
+	if (!f)
+		return -1;
+
+	// Displayed page as raw palette indices, one grayscale byte per pixel
+	fprintf(f, "P5\n128 128\n255\n");
+	fwrite(m->vram[(m->dma_flags & DMA_PAGE_OUT) ? 1 : 0], 1, PAGE_SIZE, f);
+	fclose(f);
+	return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Main
+// ---------------------------------------------------------------------------
+
+struct Press
+{
+	u16  mask;
+	u32  from, to;          // Vblank range (inclusive)
+};
+
+#define MAX_PRESSES 32
+
+static void usage(const char *prog)
+{
+	fprintf(stderr,
+		"Usage: %s [options] ROM.gtr\n"
+		"  -n, --frames N       frames to report (default 60)\n"
+		"  -s, --skip N         frames to run before reporting (default 0)\n"
+		"  -m, --mode MODE      frame boundary: 'flip' (page flips, default)\n"
+		"                       or 'vblank' (fixed 60Hz intervals)\n"
+		"  -f, --format FMT     'csv' (default) or 'json'\n"
+		"  -c, --clock HZ       CPU clock (default %d)\n"
+		"  -p, --pad MASK[@A-B] hold gamepad 1 buttons (gt_read_gamepad() bits)\n"
+		"                       from vblank A to B; may be repeated\n"
+		"  -l, --limit N        give up after N vblanks (default 100 per frame)\n"
+		"  -d, --dump FILE      write the displayed page as a PGM of raw\n"
+		"                       palette indices when done\n",
+		prog, DEFAULT_CLOCK);
+}
+
+int main(int argc, char **argv)
+{
+	int frames = 60, skip = 0, flip_mode = 1, fmt = FMT_CSV;
+	long clock = DEFAULT_CLOCK, limit = 0;
+	const char *dump = NULL;
+	struct Press presses[MAX_PRESSES];
+	int npresses = 0;
+
+	static const struct option opts[] = {
+		{"frames", required_argument, 0, 'n'},
+		{"skip",   required_argument, 0, 's'},
+		{"mode",   required_argument, 0, 'm'},
+		{"format", required_argument, 0, 'f'},
+		{"clock",  required_argument, 0, 'c'},
+		{"pad",    required_argument, 0, 'p'},
+		{"limit",  required_argument, 0, 'l'},
+		{"dump",   required_argument, 0, 'd'},
+		{"help",   no_argument,       0, 'h'},
+		{0, 0, 0, 0}
+	};
+
+	int opt;
+	while ((opt = getopt_long(argc, argv, "n:s:m:f:c:p:l:d:h", opts, NULL)) != -1)
+	{
+		switch (opt)
+		{
+		case 'n': frames = atoi(optarg); break;
+		case 's': skip = atoi(optarg); break;
+		case 'm':
+			if (!strcmp(optarg, "flip"))        flip_mode = 1;
+			else if (!strcmp(optarg, "vblank")) flip_mode = 0;
+			else { usage(argv[0]); return 2; }
+			break;
+		case 'f':
+			if (!strcmp(optarg, "csv"))         fmt = FMT_CSV;
+			else if (!strcmp(optarg, "json"))   fmt = FMT_JSON;
+			else { usage(argv[0]); return 2; }
+			break;
+		case 'c': clock = atol(optarg); break;
+		case 'l': limit = atol(optarg); break;
+		case 'd': dump = optarg; break;
+		case 'p':
+		{
+			if (npresses == MAX_PRESSES)
+			{
+				fprintf(stderr, "Too many --pad options\n");
+				return 2;
+			}
+			struct Press *pr = &presses[npresses++];
+			char *end;
+			pr->mask = (u16)strtoul(optarg, &end, 0);
+			pr->from = 0;
+			pr->to = 0xFFFFFFFF;
+			if (*end == '@' && sscanf(end + 1, "%u-%u", &pr->from, &pr->to) != 2)
+			{
+				usage(argv[0]);
+				return 2;
+			}
+			break;
+		}
+		default:
+			usage(argv[0]);
+			return opt == 'h' ? 0 : 2;
+		}
+	}
+
+	if (optind != argc - 1 || frames <= 0 || clock < FRAME_RATE)
+	{
+		usage(argv[0]);
+		return 2;
+	}
+	if (!limit)
+		limit = 100L * (frames + skip);
+
+	struct Machine *m = calloc(1, sizeof(*m));
+	m->rom = malloc(ROM_SIZE);
+	memset(m->rom, 0xFF, ROM_SIZE);
+
+	FILE *f = fopen(argv[optind], "rb");
+	if (!f)
+	{
+		perror(argv[optind]);
+		return 1;
+	}
+	size_t size = fread(m->rom, 1, ROM_SIZE, f);
+	fclose(f);
+	if (size == 0)
+	{
+		fprintf(stderr, "%s: empty ROM image\n", argv[optind]);
+		return 1;
+	}
+	if (size < ROM_SIZE)
+	{
+		// Smaller images occupy the top of the address space
+		memmove(m->rom + ROM_SIZE - size, m->rom, size);
+		memset(m->rom, 0xFF, ROM_SIZE - size);
+	}
+
+	m->cpu.read = mem_read;
+	m->cpu.write = mem_write;
+	m->cpu.ctx = m;
+	m->acp.read = acp_read;
+	m->acp.write = acp_write;
+	m->acp.ctx = m;
+	m->via.t1_counter = m->via.t2_counter = 0xFFFF;
+	cpu_reset(&m->cpu);
+
+	u32 frame_cycles = (u32)(clock / FRAME_RATE);
+	u64 next_vblank = frame_cycles;
+	u32 vblank = 0;
+	int index = 0, total = frames + skip;
+	struct Stats sum;
+	memset(&sum, 0, sizeof(sum));
+	u64 sum_end = 0;
+
+	report_header(fmt);
+
+	while (index < total)
+	{
+		if (vblank >= (u32)limit)
+		{
+			fprintf(stderr, "Stopped after %u vblanks with %d of %d frames%s\n",
+			        vblank, index, total,
+			        flip_mode ? " (is the ROM flipping pages?)" : "");
+			break;
+		}
+
+		int halted = m->cpu.stopped ||
+		             (m->cpu.waiting && !m->cpu.irq_line && !m->cpu.nmi_pending);
+		u32 flips_before = m->frame.flips;
+		u32 cycles;
+
+		if (halted)
+		{
+			// Sleep until the next event: vblank or blit completion
+			u64 until = next_vblank;
+			if (m->blit.busy && m->blit.done_at < until)
+				until = m->blit.done_at;
+			cycles = until > m->cycle ? (u32)(until - m->cycle) : 1;
+			if (cycles > 64 && ((m->via.ier & 0x7F) || (m->audio_rate & AUDIO_RUN)))
+				cycles = 64;    // Keep VIA interrupts and the coprocessor timely
+		}
+		else
+		{
+			u32 irqs = m->cpu.irqs, nmis = m->cpu.nmis;
+			cycles = cpu_step(&m->cpu);
+			m->frame.irqs += m->cpu.irqs - irqs;
+			m->frame.nmis += m->cpu.nmis - nmis;
+		}
+
+		machine_tick(m, cycles, halted);
+
+		int boundary = 0;
+		if (m->cycle >= next_vblank)
+		{
+			next_vblank += frame_cycles;
+			vblank++;
+			m->frame.vblanks++;
+
+			for (int i = 0; i < 2; i++)
+				m->pad_mask[i] = 0;
+			for (int i = 0; i < npresses; i++)
+			{
+				if (vblank >= presses[i].from && vblank <= presses[i].to)
+					m->pad_mask[0] |= presses[i].mask;
+			}
+
+			if (m->dma_flags & DMA_NMI)
+				m->cpu.nmi_pending = 1;
+			if (!flip_mode)
+				boundary = 1;
+		}
+		if (flip_mode && m->frame.flips != flips_before)
+			boundary = 1;
+
+		if (boundary)
+		{
+			if (index >= skip)
+			{
+				report_frame(fmt, index - skip, &m->frame, m->cycle);
+				sum.cpu += m->frame.cpu;
+				sum.wai += m->frame.wai;
+				sum.blits += m->frame.blits;
+				sum.pixels += m->frame.pixels;
+				sum.blit_busy += m->frame.blit_busy;
+				sum.acp += m->frame.acp;
+				sum.vblanks += m->frame.vblanks;
+				sum_end = m->cycle;
+			}
+			else
+				sum.start = m->cycle;
+
+			index++;
+			memset(&m->frame, 0, sizeof(m->frame));
+			m->frame.start = m->cycle;
+		}
+	}
+
+	report_footer(fmt);
+
+	int reported = index - skip;
+	if (reported > 0)
+	{
+		u64 cycles = sum_end - sum.start;
+		fprintf(stderr,
+		        "%d frames: %.0f cycles/frame (%.1f%% CPU, %.1f%% WAI), "
+		        "%.1f blits/frame, %.0f pixels/frame, %.2f vblanks/frame",
+		        reported, (double)cycles / reported,
+		        100.0 * sum.cpu / cycles, 100.0 * sum.wai / cycles,
+		        (double)sum.blits / reported, (double)sum.pixels / reported,
+		        (double)sum.vblanks / reported);
+		if (sum.acp)
+			fprintf(stderr, ", %.1f%% ACP", 100.0 * sum.acp / cycles);
+		fprintf(stderr, "\n");
+	}
+
+	if (dump && dump_page(m, dump))
+	{
+		perror(dump);
+		return 1;
+	}
+
+	return index < total ? 1 : 0;
+}
@@ -0,0 +1,338 @@
+// gttab — Lookup table generator for the GameTank tutorials
+//
+// Reads a list of table definitions and writes one C header and one C
+// source file holding every table, so each table is compiled into ROM
+// once and shared by all tutorials instead of being pasted into each of
+// them. build.sh runs this before compiling a tutorial whenever the
+// definitions or the generator are newer than the output.
+//
+// Definition file format, one table per line ('#' starts a comment):
+//
+//     <kind> <name> <size> [param]
+//
+//     sin    name size amp    round(amp * sin(2*PI * i / size))
+//     cos    name size amp    round(amp * cos(2*PI * i / size))
+//     atan   name size        CORDIC angles round(atan(2^-i) * 32768 / PI),
+//                             in units where 65536 is a full circle
+//                             (always a signed type)
+//     recip  name size scale  round(scale / i), saturated; entry 0 is the
+//                             largest value of the element type
+//     rsqrt  name size scale  round(scale / sqrt(i)), saturated likewise
+//     sqr    name size        i * i
+//     qsqr   name size        floor(i * i / 4), for quarter-square multiply
+//
+// The element type is the narrowest of signed char, byte, int and
+// unsigned that holds every value. 16-bit tables are declared __striped
+// so oscar64 stores low and high bytes in separate arrays.
+//
+// Build (host compiler, not oscar64):
+//     cc -O2 -o tools/gttab/gttab tools/gttab/gttab.c -lm
+//
+// Example:
+//     tools/gttab/gttab lib/gt_tables.def lib/gt_tables
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <math.h>
+
+#define MAX_TABLES  64
+#define MAX_SIZE    1024
+#define MAX_NAME    48
+
+struct Table
+{
+	char   kind[8];
+	char   name[MAX_NAME];
+	int    size;
+	double param;
+	long   value[MAX_SIZE];
+	const char *type;
+	int    wide;
+};
+
+static struct Table tables[MAX_TABLES];
+static int table_count;
+
+// ---------------------------------------------------------------------------
+// Output
+// ---------------------------------------------------------------------------
+
+// The tree uses CRLF line endings, so generated files do too
+static void emit(FILE *f, const char *fmt, ...)
+{
+	va_list ap;
+	va_start(ap, fmt);
+	vfprintf(f, fmt, ap);
+	va_end(ap);
+	fputs("\r\n", f);
+}
+
+static const char *base_name(const char *path)
+{
+	const char *s = strrchr(path, '/');
+	return s ? s + 1 : path;
+}
+
+// ---------------------------------------------------------------------------
+// Table Generation
+// ---------------------------------------------------------------------------
+
+static long saturate(double v, long max)
+{
+	return v > (double)max ? max : lround(v);
+}
+
+static int generate(struct Table *t, char *err, size_t errlen)
+{
+	const double pi = 3.14159265358979323846;
+
+	for (int i = 0; i < t->size; i++)
+	{
+		long v;
+
+		if (!strcmp(t->kind, "sin"))
+			v = lround(t->param * sin(2.0 * pi * i / t->size));
+		else if (!strcmp(t->kind, "cos"))
+			v = lround(t->param * cos(2.0 * pi * i / t->size));
+		else if (!strcmp(t->kind, "atan"))
+			v = lround(atan(ldexp(1.0, -i)) * 32768.0 / pi);
+		else if (!strcmp(t->kind, "recip"))
+			v = i ? saturate(t->param / i, 65535) : 65535;
+		else if (!strcmp(t->kind, "rsqrt"))
+			v = i ? saturate(t->param / sqrt(i), 65535) : 65535;
+		else if (!strcmp(t->kind, "sqr"))
+			v = (long)i * i;
+		else if (!strcmp(t->kind, "qsqr"))
+			v = (long)i * i / 4;
+		else
+		{
+			snprintf(err, errlen, "unknown table kind '%s'", t->kind);
+			return 0;
+		}
+
+		if (v < -32768 || v > 65535)
+		{
+			snprintf(err, errlen, "%s[%d] = %ld does not fit 16 bits", t->name, i, v);
+			return 0;
+		}
+		t->value[i] = v;
+	}
+
+	long lo = 0, hi = 0;
+	for (int i = 0; i < t->size; i++)
+	{
+		if (t->value[i] < lo) lo = t->value[i];
+		if (t->value[i] > hi) hi = t->value[i];
+	}
+
+	if (lo < 0 && hi > 32767)
+	{
+		snprintf(err, errlen, "%s spans more than 16 bits", t->name);
+		return 0;
+	}
+
+	// Saturated entries take the maximum of the type chosen for the rest
+	if (!strcmp(t->kind, "recip") || !strcmp(t->kind, "rsqrt"))
+	{
+		long rest = 0;
+		for (int i = 1; i < t->size; i++)
+			if (t->value[i] < 65535 && t->value[i] > rest)
+				rest = t->value[i];
+		long max = rest <= 255 ? 255 : 65535;
+		for (int i = 0; i < t->size; i++)
+			if (t->value[i] > max)
+				t->value[i] = max;
+		hi = hi > max ? max : hi;
+	}
+
+	// Angles are mixed with signed arithmetic, so keep them signed
+	if (lo < 0 || !strcmp(t->kind, "atan"))
+	{
+		t->wide = lo < -128 || hi > 127;
+		t->type = t->wide ? "int" : "signed char";
+	}
+	else
+	{
+		t->wide = hi > 255;
+		t->type = t->wide ? "unsigned" : "byte";
+	}
+	return 1;
+}
+
+// ---------------------------------------------------------------------------
+// Definition File
+// ---------------------------------------------------------------------------
+
+static int read_defs(const char *path)
+{
+	FILE *f = fopen(path, "r");
+	if (!f)
+	{
+		perror(path);
+		return 0;
+	}
+
+	char line[256];
+	int lineno = 0;
+	while (fgets(line, sizeof(line), f))
+	{
+		lineno++;
+
+		char *hash = strchr(line, '#');
+		if (hash)
+			*hash = 0;
+
+		struct Table t;
+		memset(&t, 0, sizeof(t));
+		char name[256];
+		int n = sscanf(line, "%7s %255s %d %lf", t.kind, name, &t.size, &t.param);
+		if (n <= 0)
+			continue;
+
+		char err[320];
+		if (n < 3)
+			snprintf(err, sizeof(err), "expected <kind> <name> <size> [param]");
+		else if (strlen(name) >= MAX_NAME)
+			snprintf(err, sizeof(err), "name '%s' is too long", name);
+		else if (t.size < 1 || t.size > MAX_SIZE)
+			snprintf(err, sizeof(err), "size %d is out of range 1..%d", t.size, MAX_SIZE);
+		else if (n < 4 && strcmp(t.kind, "atan") && strcmp(t.kind, "sqr") && strcmp(t.kind, "qsqr"))
+			snprintf(err, sizeof(err), "'%s' tables need a parameter", t.kind);
+		else if (table_count == MAX_TABLES)
+			snprintf(err, sizeof(err), "more than %d tables", MAX_TABLES);
+		else
+		{
+			strcpy(t.name, name);
+			if (generate(&t, err, sizeof(err)))
+			{
+				tables[table_count++] = t;
+				continue;
+			}
+		}
+
+		fprintf(stderr, "%s:%d: %s\n", path, lineno, err);
+		fclose(f);
+		return 0;
+	}
+
+	fclose(f);
+	return 1;
+}
+
+static void describe(char *buf, size_t len, const struct Table *t)
+{
+	if (!strcmp(t->kind, "sin") || !strcmp(t->kind, "cos"))
+		snprintf(buf, len, "%s[i] = round(%g * %.7s(i * 2*PI / %d))", t->name, t->param, t->kind, t->size);
+	else if (!strcmp(t->kind, "atan"))
+		snprintf(buf, len, "%s[i] = atan(2^-i) in 16-bit angle units (32768 = PI)", t->name);
+	else if (!strcmp(t->kind, "recip"))
+		snprintf(buf, len, "%s[i] = round(%g / i), saturated", t->name, t->param);
+	else if (!strcmp(t->kind, "rsqrt"))
+		snprintf(buf, len, "%s[i] = round(%g / sqrt(i)), saturated", t->name, t->param);
+	else if (!strcmp(t->kind, "sqr"))
+		snprintf(buf, len, "%s[i] = i * i", t->name);
+	else
+		snprintf(buf, len, "%s[i] = i * i / 4 (quarter squares)", t->name);
+}
+
+// ---------------------------------------------------------------------------
+// Writers
+// ---------------------------------------------------------------------------
+
+static int write_header(const char *path, const char *base, const char *defs)
+{
+	FILE *f = fopen(path, "wb");
+	if (!f)
+	{
+		perror(path);
+		return 0;
+	}
+
+	emit(f, "#ifndef GT_TABLES_H");
+	emit(f, "#define GT_TABLES_H");
+	emit(f, "");
+	emit(f, "// Shared lookup tables — GENERATED by tools/gttab from %s.", defs);
+	emit(f, "// Edit the definitions and rebuild instead of changing this file.");
+	emit(f, "");
+	emit(f, "#include \"gt.h\"");
+
+	for (int i = 0; i < table_count; i++)
+	{
+		const struct Table *t = &tables[i];
+		char desc[256];
+		describe(desc, sizeof(desc), t);
+		emit(f, "");
+		emit(f, "// %s", desc);
+		emit(f, "extern const %s%s %s[%d];", t->type, t->wide ? " __striped" : "", t->name, t->size);
+	}
+
+	emit(f, "");
+	emit(f, "#pragma compile(\"%s.c\")", base);
+	emit(f, "");
+	emit(f, "#endif");
+	fclose(f);
+	return 1;
+}
+
+static int write_source(const char *path, const char *base)
+{
+	FILE *f = fopen(path, "wb");
+	if (!f)
+	{
+		perror(path);
+		return 0;
+	}
+
+	emit(f, "// Shared lookup tables — GENERATED by tools/gttab, do not edit.");
+	emit(f, "");
+	emit(f, "#include \"%s.h\"", base);
+
+	for (int i = 0; i < table_count; i++)
+	{
+		const struct Table *t = &tables[i];
+		emit(f, "");
+		emit(f, "const %s%s %s[%d] = {", t->type, t->wide ? " __striped" : "", t->name, t->size);
+
+		int width = t->wide ? 6 : 4;
+		for (int j = 0; j < t->size; j += 16)
+		{
+			char row[16 * 10 + 8];
+			int pos = sprintf(row, "\t");
+			for (int k = j; k < j + 16 && k < t->size; k++)
+				pos += sprintf(row + pos, "%*ld%s", width, t->value[k], k + 1 < t->size ? ", " : "");
+			while (pos > 0 && row[pos - 1] == ' ')
+				row[--pos] = 0;
+			emit(f, "%s", row);
+		}
+		emit(f, "};");
+	}
+
+	fclose(f);
+	return 1;
+}
+
+int main(int argc, char **argv)
+{
+	if (argc != 3)
+	{
+		fprintf(stderr, "Usage: %s <definitions> <output base>\n", argv[0]);
+		fprintf(stderr, "Writes <output base>.h and <output base>.c\n");
+		return 2;
+	}
+
+	if (!read_defs(argv[1]))
+		return 1;
+
+	char hpath[1024], cpath[1024];
+	snprintf(hpath, sizeof(hpath), "%s.h", argv[2]);
+	snprintf(cpath, sizeof(cpath), "%s.c", argv[2]);
+
+	const char *base = base_name(argv[2]);
+	if (!write_header(hpath, base, base_name(argv[1])) || !write_source(cpath, base))
+		return 1;
+
+	fprintf(stderr, "gttab: %d tables -> %s, %s\n", table_count, hpath, cpath);
+	return 0;
+}